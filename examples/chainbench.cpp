@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include <CL/cl.h>
+
+#include <miopengemm/gemm.hpp>
+#include <miopengemm/geometries.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/oclutil.hpp>
+#include <miopengemm/timer.hpp>
+
+// Compare n_steps launches of xgemm with one launch of xgemm_chain, on the recurrent steps of
+// the DeepBench RNN problems, h_{t+1} = W h_t, where W is m x m and h_t is m x n. The final
+// states h_{n_steps} of the two are compared.
+int main()
+{
+
+  using namespace MIOpenGEMM;
+
+  size_t n_steps   = 8;
+  size_t n_repeats = 20;
+  // relative to the largest |h|, the kernels of the two may sum in different orders
+  double tolerance = 1e-5;
+  bool   all_agree = true;
+
+  owrite::Writer                 mowri(Ver::E::TERMINAL, "");
+  CLHint                         devhint(0, 0);
+  oclutil::CommandQueueInContext cqic(mowri, 0, devhint, "chainbench");
+  cl_command_queue               queue = cqic.command_queue;
+
+  std::vector<Geometry> geometries;
+  for (auto& gg : get_deepbench(0))
+  {
+    if (gg.m == gg.k && !gg.tX[Mat::E::A] && !gg.tX[Mat::E::B] && gg.n <= 32)
+    {
+      geometries.push_back(gg);
+    }
+  }
+
+  std::cout << "\n" << std::setw(8) << "m" << std::setw(8) << "n" << std::setw(16) << "xgemm [ms]"
+            << std::setw(16) << "chain [ms]" << std::setw(12) << "speedup" << std::setw(14)
+            << "rel diff" << '\n';
+
+  for (auto& gg : geometries)
+  {
+    size_t m = gg.m;
+    size_t n = gg.n;
+
+    float alpha = 1.0;
+    float beta  = 0.0;
+
+    // W, of mean 1/m, and the states h_0 ... h_{n_steps}, of which only h_0 is set
+    std::vector<float> W(m * m);
+    for (size_t i = 0; i < W.size(); ++i)
+    {
+      W[i] = ((i * 7919) % 101) / (50. * m);
+    }
+    std::vector<float> H((n_steps + 1) * m * n, 0.0);
+    for (size_t i = 0; i < m * n; ++i)
+    {
+      H[i] = 1. + (i % 13) / 13.;
+    }
+
+    std::vector<cl_ulong> chain_table;
+    for (size_t t = 0; t < n_steps; ++t)
+    {
+      chain_table.insert(chain_table.end(), {0, t * m * n, (t + 1) * m * n});
+    }
+
+    oclutil::SafeClMem dev_w("chainbench w");
+    oclutil::SafeClMem dev_h("chainbench h");
+    oclutil::SafeClMem dev_table("chainbench table");
+    oclutil::SafeClMem dev_state("chainbench state");
+
+    auto make_buffer = [&queue](oclutil::SafeClMem& mem, size_t size, const void* host) {
+      oclutil::cl_set_buffer_from_command_queue(
+        mem.clmem, queue, CL_MEM_READ_WRITE, size, nullptr, mem.hash, true);
+      if (host != nullptr)
+      {
+        oclutil::cl_enqueue_write_buffer(
+          queue, mem.clmem, CL_TRUE, 0, size, host, 0, nullptr, nullptr, mem.hash, true);
+      }
+    };
+
+    make_buffer(dev_w, W.size() * sizeof(float), W.data());
+    make_buffer(dev_h, H.size() * sizeof(float), H.data());
+    make_buffer(dev_table, chain_table.size() * sizeof(cl_ulong), chain_table.data());
+    make_buffer(dev_state, n_steps * sizeof(cl_int), nullptr);
+
+    // the first calls find (or look up) the kernels, and compile them
+    int ID_gemm =
+      xgemm<float>(true, false, false, m, n, m, alpha, dev_w.clmem, 0, m, dev_h.clmem, 0, m,
+                   beta, dev_h.clmem, m * n, m, nullptr, 0, 0, &queue, 0, nullptr, nullptr, -1)
+        .ID;
+
+    int ID_chain = xgemm_chain<float>(true, false, false, m, n, m, alpha, dev_w.clmem, 0, m,
+                                      dev_h.clmem, 0, m, beta, dev_h.clmem, 0, m,
+                                      dev_table.clmem, dev_state.clmem, n_steps, &queue, 0,
+                                      nullptr, nullptr, -1)
+                     .ID;
+    clFinish(queue);
+
+    Timer timer;
+    timer.start();
+    for (size_t r = 0; r < n_repeats; ++r)
+    {
+      for (size_t t = 0; t < n_steps; ++t)
+      {
+        xgemm<float>(true, false, false, m, n, m, alpha, dev_w.clmem, 0, m, dev_h.clmem,
+                     t * m * n, m, beta, dev_h.clmem, (t + 1) * m * n, m, nullptr, 0, 0,
+                     &queue, 0, nullptr, nullptr, ID_gemm);
+      }
+    }
+    clFinish(queue);
+    double t_gemm = 1000 * timer.get_elapsed() / n_repeats;
+
+    // h_{n_steps} of the xgemm launches, then reset h_1 ... h_{n_steps} for the chain
+    std::vector<float> h_gemm(m * n);
+    std::vector<float> h_chain(m * n);
+    auto read_final = [&](std::vector<float>& h_final) {
+      oclutil::cl_enqueue_read_buffer(queue, dev_h.clmem, CL_TRUE, n_steps * m * n * sizeof(float),
+                                      m * n * sizeof(float), h_final.data(), 0, nullptr, nullptr,
+                                      "chainbench h_final", true);
+    };
+    read_final(h_gemm);
+    oclutil::cl_enqueue_write_buffer(queue, dev_h.clmem, CL_TRUE, 0, H.size() * sizeof(float),
+                                     H.data(), 0, nullptr, nullptr, dev_h.hash, true);
+
+    timer.start();
+    for (size_t r = 0; r < n_repeats; ++r)
+    {
+      xgemm_chain<float>(true, false, false, m, n, m, alpha, dev_w.clmem, 0, m, dev_h.clmem, 0,
+                         m, beta, dev_h.clmem, 0, m, dev_table.clmem, dev_state.clmem, n_steps,
+                         &queue, 0, nullptr, nullptr, ID_chain);
+    }
+    clFinish(queue);
+    double t_chain = 1000 * timer.get_elapsed() / n_repeats;
+    read_final(h_chain);
+
+    double max_h    = 0;
+    double max_diff = 0;
+    for (size_t i = 0; i < m * n; ++i)
+    {
+      max_h    = std::max<double>(max_h, std::abs(h_gemm[i]));
+      max_diff = std::max<double>(max_diff, std::abs(h_gemm[i] - h_chain[i]));
+    }
+    // NaN compares false, so check agreement rather than disagreement
+    double rel_diff = max_diff / std::max(max_h, 1e-30);
+    bool   agree    = max_h > 0 && rel_diff <= tolerance;
+    all_agree       = all_agree && agree;
+
+    std::cout << std::setw(8) << m << std::setw(8) << n << std::setw(16) << t_gemm
+              << std::setw(16) << t_chain << std::setw(12) << t_gemm / t_chain << std::setw(14)
+              << rel_diff << (agree ? "" : "   FAILED") << '\n';
+  }
+
+  if (!all_agree)
+  {
+    std::cout << "\nthe final states of xgemm and xgemm_chain differ, FAILED\n";
+    return 1;
+  }
+  return 0;
+}
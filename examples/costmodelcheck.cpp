@@ -0,0 +1,81 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <miopengemm/checkpoint.hpp>
+#include <miopengemm/costmodel.hpp>
+
+// Evaluate the CostModel against the times recorded in a find checkpoint, on the CPU only :
+// how often the model orders two HyPas as their recorded times do, and where the fastest
+// recorded HyPas ranks among the model's predictions.
+// usage : costmodelcheck checkpoint_path (peak gflops) (gbytes per second)
+
+int main(int argc, char* argv[])
+{
+  using namespace MIOpenGEMM;
+
+  if (argc < 2)
+  {
+    std::cout << "usage : costmodelcheck checkpoint_path (peak gflops) (gbytes per second)\n";
+    return 1;
+  }
+
+  auto     checkpoint = read_checkpoint(argv[1]);
+  Geometry gg(checkpoint.geometry);
+
+  // the device is only known by its identifier, so the model uses default peaks unless given
+  oclutil::DevInfo devinfo(checkpoint.identifier, checkpoint.identifier, 64);
+  devinfo.device_local_mem_size = 65536;
+  CostModel model(devinfo, argc > 2 ? std::stod(argv[2]) : 0, argc > 3 ? std::stod(argv[3]) : 0);
+
+  // (recorded, predicted), of HyPas which ran
+  std::vector<std::tuple<double, double>> times;
+  for (auto& x : checkpoint.get_recorded())
+  {
+    if (std::get<1>(x) < std::numeric_limits<double>::max())
+    {
+      times.emplace_back(std::get<1>(x), model.get_time(std::get<0>(x), gg));
+    }
+  }
+
+  if (times.size() < 2)
+  {
+    std::cout << "fewer than 2 recorded times in " << argv[1] << '\n';
+    return 1;
+  }
+
+  size_t n_concordant = 0;
+  size_t n_pairs      = 0;
+  for (size_t i = 0; i < times.size(); ++i)
+  {
+    for (size_t j = i + 1; j < times.size(); ++j)
+    {
+      ++n_pairs;
+      bool recorded_less  = std::get<0>(times[i]) < std::get<0>(times[j]);
+      bool predicted_less = std::get<1>(times[i]) < std::get<1>(times[j]);
+      n_concordant += (recorded_less == predicted_less);
+    }
+  }
+
+  std::sort(times.begin(), times.end());
+  double best_predicted = std::get<1>(times[0]);
+  size_t best_rank      = 0;
+  for (auto& x : times)
+  {
+    best_rank += (std::get<1>(x) < best_predicted);
+  }
+
+  std::cout << "geometry              : " << gg.get_string() << '\n'
+            << "recorded HyPas        : " << times.size() << '\n'
+            << "pairs ordered right   : " << static_cast<double>(n_concordant) / n_pairs
+            << " (0.5 is random)\n"
+            << "predicted rank of the fastest : " << best_rank << " of " << times.size() << '\n'
+            << "fastest recorded      : " << std::get<0>(times[0])
+            << " [ms], predicted : " << best_predicted << " [ms]\n";
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/graph.hpp>
+#include <miopengemm/randomutil.hpp>
+#include <miopengemm/timer.hpp>
+
+// Microbenchmark of the derivability checks, is_dvble versus Derivabilty,
+// over millions of random HyPas drawn from the full ranges of the Graph. No device is required.
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  size_t           n_hps = 2000000;
+  RandomUtil       radutil(17);
+  oclutil::DevInfo devinfo = oclutil::get_fiji_devinfo();
+  Constraints      no_constraints("");
+
+  for (auto& gg : std::vector<Geometry>{
+         {"tC0_tA1_tB0_colMaj1_m6144_n16_k2048_lda2048_ldb2048_ldc6144_ws0_f32"},
+         {"tC0_tA0_tB0_colMaj1_m1760_n7000_k1760_lda1760_ldb1760_ldc1760_ws20000000_f32"}})
+  {
+    ASuGr asubg(gg, no_constraints.sub[Mat::E::A], devinfo);
+    BSuGr bsubg(gg, no_constraints.sub[Mat::E::B], devinfo);
+    CSuGr csubg(gg, no_constraints.sub[Mat::E::C], devinfo);
+
+    std::array<SuGr*, Mat::E::N> subgs{{&asubg, &bsubg, &csubg}};
+    for (auto subg : subgs)
+    {
+      subg->initialise();
+    }
+
+    std::vector<HyPas> hps(n_hps);
+    for (auto& hp : hps)
+    {
+      for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+      {
+        auto&               range = subgs[emat]->range;
+        std::vector<size_t> vs(range.size());
+        for (size_t hpi = 0; hpi < vs.size(); ++hpi)
+        {
+          vs[hpi] = range[hpi][radutil.get_from_range(range[hpi].size())];
+        }
+        hp.sus[emat] = SuHy(emat, std::move(vs));
+      }
+    }
+
+    Timer  timer;
+    size_t n_fast = 0;
+    timer.start();
+    for (auto& hp : hps)
+    {
+      n_fast += is_dvble(hp, gg);
+    }
+    double t_fast = timer.get_elapsed();
+
+    size_t n_slow = 0;
+    timer.start();
+    for (auto& hp : hps)
+    {
+      try
+      {
+        n_slow += Derivabilty(hp, gg).is_derivable;
+      }
+      catch (const miog_error&)
+      {
+      }
+    }
+    double t_slow = timer.get_elapsed();
+
+    std::cout << gg.get_string() << '\n'
+              << n_hps << " random HyPas, " << n_fast << " (is_dvble) and " << n_slow
+              << " (Derivabilty) derivable\n"
+              << "is_dvble    : " << 1e9 * t_fast / n_hps << " [ns / HyPas]\n"
+              << "Derivabilty : " << 1e9 * t_slow / n_hps << " [ns / HyPas]\n"
+              << "speed-up    : " << t_slow / t_fast << "\n\n";
+  }
+  return 0;
+}
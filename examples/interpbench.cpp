@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <miopengemm/kernelcache.hpp>
+#include <miopengemm/nearest.hpp>
+#include <miopengemm/tinyone.hpp>
+
+// Compare kernel cache interpolation with nearest neighbor lookup on held-out geometries.
+// Each cache entry (of this device, f32) is removed from the cache in turn. If the
+// remaining cache brackets it, both the interpolated and the nearest HyPas are benchmarked.
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  CLHint           devhint(0, 0);
+  owrite::Writer   silent_mowri(Ver::E::SILENT, "");
+  oclutil::DevInfo devinfo(devhint, silent_mowri);
+  Offsets          offsets = get_zero_offsets();
+  Halt             halt({{0, 10}}, {{0, 0.1}});
+
+  auto&& kernel_cache = get_kernel_cache(devinfo.identifier, 'f');
+  auto   cache_keys   = kernel_cache.get_keys();
+
+  std::cout << cache_keys.size() << " cache entries for device " << devinfo.identifier << "\n\n";
+
+  std::vector<double> v_ratios;
+  for (auto& held_out : cache_keys)
+  {
+    KernelCache held_out_cache;
+    for (auto& key : cache_keys)
+    {
+      if (!(key == held_out))
+      {
+        held_out_cache.add(key, kernel_cache.at(key));
+      }
+    }
+
+    Graph graph(held_out.gg, devinfo, held_out.constraints, silent_mowri);
+    auto  interpolated = nearest::get_interpolated(held_out, graph, held_out_cache);
+    if (!interpolated.is_interpolated ||
+        !nearest::is_within(held_out, graph, held_out_cache, std::numeric_limits<double>::max(), 0))
+    {
+      continue;
+    }
+
+    HyPas hp_nearest = held_out_cache.at(nearest::get(held_out, graph, held_out_cache, 0));
+
+    dev::TinyOne<float> diva(held_out.gg, offsets, silent_mowri, devhint);
+    auto                times = diva.benchgemm({interpolated.hp, hp_nearest}, halt);
+
+    // times are in milliseconds, get_gflops takes seconds.
+    double gflops_interpolated =
+      held_out.gg.get_gflops(*std::min_element(times[0].begin(), times[0].end()) / 1000.);
+    double gflops_nearest =
+      held_out.gg.get_gflops(*std::min_element(times[1].begin(), times[1].end()) / 1000.);
+    v_ratios.push_back(gflops_interpolated / gflops_nearest);
+
+    std::cout << held_out.gg.get_string() << "\ninterpolated : " << std::setw(10)
+              << gflops_interpolated << " [GFlops]    nearest : " << std::setw(10)
+              << gflops_nearest << " [GFlops]\n\n";
+  }
+
+  if (v_ratios.size() == 0)
+  {
+    std::cout << "No held-out cache entries could be interpolated" << std::endl;
+    return 0;
+  }
+
+  double log_sum = 0;
+  size_t n_wins  = 0;
+  for (auto& x : v_ratios)
+  {
+    log_sum += std::log(x);
+    n_wins += (x > 1);
+  }
+
+  std::cout << "held-out geometries interpolated : " << v_ratios.size() << '\n'
+            << "interpolated faster than nearest : " << n_wins << '\n'
+            << "geometric mean GFlops ratio (interpolated / nearest) : "
+            << std::exp(log_sum / v_ratios.size()) << std::endl;
+
+  return 0;
+}
@@ -3,85 +3,65 @@
  *******************************************************************************/
 #include <iostream>
 #include <string>
-#include <miopengemm/geometries.hpp>
-#include <miopengemm/tinytwo.hpp>
+#include <miopengemm/findfarm.hpp>
+#include <miopengemm/kernelcache.hpp>
 
-int main()
+// Finds for the large geometries of the kernel cache, with a FindFarm.
+// usage : multifind basedir [platform_id device_id]*
+// basedir gets a log per job, and the merged results in tuningdb.txt and cacheentries.txt.
+// One worker is used per (platform_id, device_id) pair, by default one on the only device.
+int main(int argc, char* argv[])
 {
 
-  srand(time(NULL));
-
   using namespace MIOpenGEMM;
 
-  std::vector<Constraints> constraints_s{{""}};
-
-  // std::vector<Geometry> geometries;
-
-  // std::vector<Geometry> geometries0 = get_deepbench(0);
-  // for (auto & gg : geometries0)
-  //{
-  // if (gg.m*gg.n*gg.k > 1000*1000*1000 && gg.m*gg.n*gg.k < 8000L*1000L*1000L){
-  // geometries.push_back(gg);
-  //}
-  //}
-
-  // auto m = geometries[i].m;
-  // auto n = geometries[i].n;
-  // auto k = geometries[i].k;
-  // geometries[i].wSpaceSize = (m + 16)*(k + 16) + (n + 16)*(k + 16);
-  //}
-
-  std::vector<Geometry> geometries;
+  if (argc < 2 || argc % 2 != 0)
+  {
+    std::cout << "usage : multifind basedir [platform_id device_id]*" << std::endl;
+    return 1;
+  }
 
-  auto&& kernel_cache = get_kernel_cache();
-  auto   keys         = kernel_cache.get_keys();
-  for (auto& key : keys)
+  std::string basedir(argv[1]);
+  FarmParams  params;
+  if (argc > 2)
   {
-    // if (key.gg.wSpaceSize > 0){
-    // auto gg = key.gg;
-    // auto m = gg.m;
-    // auto n = gg.n;
-    // auto k = gg.k;
-    // auto wSpaceSize = (m + 16)*(k + 16) + (n + 16)*(k + 16);
-    // geometries.push_back({m,n,k, gg.tX[Mat::E::A], gg.tX[Mat::E::B], wSpaceSize, 'f'});
-    //}
+    params.devices.clear();
+    for (int i = 2; i < argc; i += 2)
+    {
+      params.devices.emplace_back(std::stoul(argv[i]), std::stoul(argv[i + 1]));
+    }
+  }
+  params.find_params         = get_at_least_n_restarts(5);
+  params.find_params.sumstat = SummStat::E::MEDIAN;
+  params.job_timeout         = 3600;
+  params.max_attempts        = 2;
+  params.logdir              = basedir;
+  params.database_path       = basedir + "tuningdb.txt";
 
+  std::vector<FarmJob> jobs;
+  auto&&               kernel_cache = get_kernel_cache();
+  for (auto& key : kernel_cache.get_keys())
+  {
     if (kernel_cache.at(key).sus[Mat::E::C].vs[NonChi::MAC] == 1 &&
         key.gg.m * key.gg.n * key.gg.k > 100 * 100 * 100)
     {
-      geometries.push_back(key.gg);
-      std::cout << key.gg.get_string() << std::endl;
+      jobs.emplace_back(key.gg, Constraints(""));
     }
-
-    // if (key.gg.wSpaceSize == 0 && key.gg.m * key.gg.n * key.gg.k > 1) //250 * 250 * 250)
-    //{
-    // geometries.push_back(key.gg);
-    //}
   }
+  std::cout << "n jobs : " << jobs.size() << std::endl;
 
-  for (unsigned i = 0; i < geometries.size(); ++i)
-  {
-    std::swap(geometries[i], geometries[i + rand() % (geometries.size() - i)]);
-  }
+  owrite::Writer mowri(Ver::E::TERMINAL, "");
+  FindFarm       farm(params, mowri);
+  auto           results = farm.run(jobs);
 
-  std::cout << "n geometries : " << geometries.size() << std::endl;
-  size_t                counter = 0;
-  std::vector<Solution> solutions;
-  for (auto& gg : geometries)
+  size_t n_found = 0;
+  for (auto& result : results)
   {
-    for (auto& cons : constraints_s)
-    {
-      ++counter;
-      std::cout << '(' << counter << ')' << std::endl;
-      std::string basedir = "/home/james/test49/";
-      // WARNING : this call might only work on linux/mac
-      std::string syscall =
-        "./examples/multifindbase " + basedir + " " + gg.get_string() + " " + cons.get_string();
-      // The reason we use a system call here is that if all done directly in loop,
-      // compilation gets much slower. I don't know why.
-      std::system(syscall.c_str());
-    }
+    n_found += result.is_found;
   }
+  std::cout << n_found << " of " << results.size() << " jobs found a solution" << std::endl;
 
+  owrite::Writer mowri_entries(Ver::E::TOFILE, basedir + "cacheentries.txt");
+  mowri_entries << farm.get_database().get_cache_entries_string() << Flush;
   return 0;
 }
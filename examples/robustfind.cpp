@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <iostream>
+#include <string>
+#include <vector>
+#include <miopengemm/robustfind.hpp>
+
+// Find one HyPas for a fully connected layer whose batch size (n) varies at run time, from 1 to
+// 256, minimising the worst slowdown relative to the cached solutions of each batch size.
+// usage : robustfind (seconds, default 120)
+
+int main(int argc, char* argv[])
+{
+  using namespace MIOpenGEMM;
+
+  double seconds = argc > 1 ? std::stod(argv[1]) : 120.;
+
+  std::vector<Geometry> geometries;
+  std::vector<double>   weights;
+  for (size_t n : {1, 4, 16, 32, 64, 128, 256})
+  {
+    geometries.emplace_back(1760, n, 1760, false, false, 0, 'f');
+    weights.push_back(1);
+  }
+
+  owrite::Writer  mowri(Ver::E::TERMINAL, "");
+  CLHint          devhint;
+  dev::RobustFind robust(geometries, weights, mowri, devhint);
+
+  auto find_params = get_at_least_n_seconds(seconds);
+  auto soln        = robust.find(find_params, Constraints(""), RobustObjective::E::WORST_SLOWDOWN);
+
+  std::cout << "worst slowdown " << soln.get_worst_slowdown() << " with "
+            << soln.hypas.get_string() << "\n\n"
+            << soln.get_cache_entries_string();
+  return 0;
+}
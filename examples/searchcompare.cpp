@@ -0,0 +1,101 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <miopengemm/geometries.hpp>
+#include <miopengemm/tinyone.hpp>
+
+// Compare search strategies on the DeepBench geometries, with anytime curves : the GFlops of the
+// best solution found by greedy descent, by the surrogate model search and by the evolutionary
+// search, after fixed fractions of the same time budget per geometry.
+// usage : searchcompare (seconds per find, default 60) (number of geometries, default 8)
+
+int main(int argc, char* argv[])
+{
+  using namespace MIOpenGEMM;
+
+  double seconds      = argc > 1 ? std::stod(argv[1]) : 60.;
+  size_t n_geometries = argc > 2 ? std::stoul(argv[2]) : 8;
+
+  CLHint         devhint(0, 0);
+  owrite::Writer silent_mowri(Ver::E::SILENT, "");
+  Offsets        offsets = get_zero_offsets();
+  Constraints    constraints("");
+
+  // spread the geometries over the DeepBench set
+  auto                  deepbench = get_deepbench(0);
+  std::vector<Geometry> geometries;
+  for (size_t i = 0; i < std::min(n_geometries, deepbench.size()); ++i)
+  {
+    geometries.push_back(deepbench[(i * deepbench.size()) / n_geometries]);
+  }
+
+  std::vector<SearchType::E> searches = {
+    SearchType::E::DESCENT, SearchType::E::SURROGATE, SearchType::E::EVOLUTION};
+  std::vector<double> fractions = {0.125, 0.25, 0.5, 1.0};
+
+  // the sums over geometries of the log of the best GFlops, per search and elapsed fraction
+  std::vector<std::vector<double>> log_sums(searches.size(),
+                                            std::vector<double>(fractions.size(), 0));
+
+  auto print_header = [&seconds, &fractions]() {
+    std::cout << std::setw(12) << "best after :";
+    for (auto& f : fractions)
+    {
+      std::cout << std::setw(12) << std::to_string(static_cast<int>(f * seconds)) + " [s]";
+    }
+    std::cout << "   [GFlops]\n";
+  };
+
+  for (auto& gg : geometries)
+  {
+    std::cout << gg.get_string() << '\n';
+    print_header();
+    for (size_t si = 0; si < searches.size(); ++si)
+    {
+      auto find_params   = get_at_least_n_seconds(seconds);
+      find_params.search = searches[si];
+
+      dev::TinyOne<float> diva(gg, offsets, silent_mowri, devhint);
+      diva.find1(find_params, constraints);
+      auto best_path = diva.get_best_path();
+
+      std::cout << std::setw(12) << SearchType::M().name[searches[si]] + " :";
+      for (size_t fi = 0; fi < fractions.size(); ++fi)
+      {
+        // the fastest time [ms] found before fractions[fi] of the budget, 0 GFlops if none
+        double gflops = 0;
+        for (auto& x : best_path)
+        {
+          if (std::get<0>(x) <= fractions[fi] * seconds)
+          {
+            gflops = gg.get_gflops(std::get<1>(x) / 1000.);
+          }
+        }
+        log_sums[si][fi] += std::log(std::max(gflops, 1e-3));
+        std::cout << std::setw(12) << gflops;
+      }
+      std::cout << '\n';
+    }
+    std::cout << '\n';
+  }
+
+  std::cout << "geometric mean over geometries of the best GFlops :\n";
+  print_header();
+  for (size_t si = 0; si < searches.size(); ++si)
+  {
+    std::cout << std::setw(12) << SearchType::M().name[searches[si]] + " :";
+    for (size_t fi = 0; fi < fractions.size(); ++fi)
+    {
+      std::cout << std::setw(12) << std::exp(log_sums[si][fi] / geometries.size());
+    }
+    std::cout << '\n';
+  }
+  return 0;
+}
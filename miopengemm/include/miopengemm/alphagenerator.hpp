@@ -15,6 +15,18 @@ namespace alphagen
 {
 
 KernBlob get_alpha_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+
+// The main kernel for a chain of problems of geometry gg, with n_persistent_groups work groups
+// looping over the tiles. The offsets of the problems are in a table on the device (see
+// xgemm_chain), and the kernel has arguments chain_table, n_chain and chain_state after beta.
+KernBlob get_alpha_chain_kernelstring(const HyPas&         hp,
+                                      const Geometry&      gg,
+                                      const DerivedParams& dp,
+                                      size_t               n_persistent_groups);
+
+// With IEK, the kernel of the tiles on the ragged edges of C. The main kernel then processes the
+// interior tiles, without bounds checks.
+KernBlob get_alpha_edge_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
 }
 }
 
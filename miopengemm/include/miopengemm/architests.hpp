@@ -13,6 +13,30 @@ namespace MIOpenGEMM
 namespace architests
 {
 
+// An analytic estimate of the resources used by the main kernel, from the micro tile sizes and
+// loads alone (no compilation). Register limits are those of GCN, per SIMD lane.
+class Resources
+{
+  public:
+  // 32-bit registers per work item
+  size_t vgprs;
+  size_t sgprs;
+  size_t lds_bytes;
+  size_t waves_per_workgroup;
+  // work groups which can be resident on a compute unit, limited by registers and LDS
+  size_t workgroups_per_cu;
+  // resident waves per SIMD, relative to the maximum (10 on GCN)
+  double occupancy;
+  // fraction of the bytes of global memory transactions (to load A and B) which are used
+  double load_efficiency;
+
+  Resources(const oclutil::DevInfo&, const DerivedParams&, const Geometry&, const HyPas&);
+  std::string get_string() const;
+};
+
+// Whether a kernel can run on a device. Checked before compiling, so a kernel which fails is
+// never compiled. The Resources estimate is not checked against compiler register counts, so a
+// kernel which it says would spill is not rejected, but has occupancy 0 and is tried last.
 class Stat
 {
   public:
@@ -20,6 +44,10 @@ class Stat
   std::string msg;
   Stat(const oclutil::DevInfo&, const DerivedParams&, const Geometry&, const HyPas&);
 };
+
+// below these Resources estimates, find tries a kernel after the others of its front
+const double low_occupancy       = 0.1;
+const double low_load_efficiency = 0.5;
 }
 }
 
@@ -37,6 +37,11 @@ class BaseGenerator
   bool u_w = false;
   bool u_alpha = false;
   bool u_beta = false;
+  // if w is used with c, it is const unless this is set (in set_usage)
+  bool writes_w = false;
+  // if a or b may be the c of an earlier problem in the same kernel (a chain of problems), they
+  // are read without `restrict', so that the loads are not cached past the chain synchronisation
+  bool restrict_ab = true;
 
   std::string get_time_string();
   std::string get_what_string();
@@ -46,6 +51,10 @@ class BaseGenerator
   virtual size_t get_local_work_size() = 0;
   virtual size_t get_n_work_groups()   = 0;
 
+  // the tiles of C which this kernel processes : with IEK, the interior kernel has no edge tiles
+  virtual size_t get_use_edge_trick() const { return dp.main_use_edge_trick; }
+  virtual size_t get_n_groups(Mat::E emat_x) const { return dp.at(emat_x).n_groups; }
+
   private:
   virtual void set_type() = 0;
   void         set_kernelname() { kernelname = "miog_" + type; }
@@ -80,6 +89,9 @@ class BaseGenerator
 
   void append_fargs(std::stringstream& ss);
 
+  // kernel specific arguments, after a, b, c, w, alpha and beta
+  virtual void append_additional_fargs(std::stringstream&) {}
+
   void append_unroll_block_geometry(Mat::E             emat_x,
                                     std::stringstream& ss,
                                     bool               withcomments,
@@ -91,6 +103,9 @@ class BaseGenerator
                                  bool               withcomments,
                                  std::string        macro_prefix,
                                  bool               append_stride_definitions);
+
+  // STRIDE_PLL_M_C and STRIDE_PLL_N_C, the strides in c along m and n
+  void append_stride_c_defn(std::stringstream& ss);
 };
 }
 }
@@ -33,8 +33,9 @@ class ByLineGenerator : public prepgen::PrepGenerator
   ByLineGenerator(Mat::E emat_x, const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_);
   virtual ~ByLineGenerator() = default;
 
-  virtual KernBlob get_kernelstring() final override;
-  virtual void     setup_final() final override;
+  virtual void setup_final() final override;
+  virtual void append_definitions(std::stringstream& ss) final override;
+  virtual void append_body(std::stringstream& ss) final override;
 
   private:
   void append_description_string(std::stringstream& ss);
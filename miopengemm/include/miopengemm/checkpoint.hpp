@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_CHECKPOINT_HPP
+#define GUARD_MIOPENGEMM_CHECKPOINT_HPP
+
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/hyperparams.hpp>
+#include <miopengemm/packedhypas.hpp>
+
+namespace MIOpenGEMM
+{
+
+// The state of a find, written periodically so that a find can resume after a crash or
+// preemption. Every benchmarked HyPas is recorded with its time [ms], and is not benchmarked
+// again by a resumed find.
+class FindCheckpoint
+{
+  public:
+  std::string identifier;
+  std::string geometry;
+  std::string constraints;
+
+  // see FindTracker::get_state and get_graph_random_state
+  std::string tracker_state;
+  std::string random_state;
+
+  // the solutions (HyPas and time) of completed descents
+  std::vector<std::tuple<HyPas, double>> solutions;
+  size_t                                 warmstart_rank{0};
+
+  // the current descent : its front, and the best HyPas (and time) it has found
+  std::vector<HyPas> front;
+  bool               has_incumbent{false};
+  HyPas              incumbent;
+  double             incumbent_time{0};
+
+  FindCheckpoint() = default;
+  FindCheckpoint(const std::string& identifier, const Geometry& gg, const Constraints&);
+
+  void record(const HyPas& hp, double time);
+  // false if hp has not been recorded
+  bool   get_time(const HyPas& hp, double& time) const;
+  size_t get_n_recorded() const;
+  std::vector<std::tuple<HyPas, double>> get_recorded() const;
+
+  // written to a temporary file which is then renamed, so that path is always complete
+  void write(const std::string& path) const;
+
+  private:
+  std::unordered_map<PackedHyPas, double, PackedHyPasHash> recorded;
+
+  friend FindCheckpoint read_checkpoint(const std::string& path);
+};
+
+FindCheckpoint read_checkpoint(const std::string& path);
+
+// read_checkpoint, throwing if it is not a checkpoint of this device, geometry and constraints
+FindCheckpoint read_checkpoint(const std::string& path,
+                               const std::string& identifier,
+                               const Geometry&    gg,
+                               const Constraints& constraints);
+}
+
+#endif
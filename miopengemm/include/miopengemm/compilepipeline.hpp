@@ -0,0 +1,95 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_COMPILEPIPELINE_HPP
+#define GUARD_MIOPENGEMM_COMPILEPIPELINE_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/hyperparams.hpp>
+#include <miopengemm/kernelstring.hpp>
+#include <miopengemm/oclutil.hpp>
+#include <miopengemm/outputwriter.hpp>
+#include <miopengemm/programs.hpp>
+
+namespace MIOpenGEMM
+{
+
+// A candidate of the hyper front, with its kernels generated and (if it passed the architests)
+// compiled. If generation or compilation threw, the exception is in error.
+class CompiledCandidate
+{
+  public:
+  HyPas                 hp;
+  std::vector<KernBlob> v_tgks;
+  Programs              programs;
+  bool                  is_good{false};
+  std::string           msg;
+  std::exception_ptr    error;
+};
+
+// Generates and compiles the candidates of a hyper front on worker threads, ahead of the
+// candidate being benchmarked. Candidates are taken in order. At most n_ahead candidates are
+// compiled (or being compiled) but not yet taken. Submitting a new front cancels the current
+// one : queued candidates are dropped, and those being compiled are discarded when done.
+// Candidates flagged as skipped on submission are neither compiled nor taken.
+class CompilePipeline
+{
+  public:
+  CompilePipeline(cl_device_id            device_id,
+                  cl_context              context,
+                  const Geometry&         gg,
+                  const oclutil::DevInfo& devinfo,
+                  size_t                  n_ahead,
+                  owrite::Writer&         mowri);
+
+  ~CompilePipeline();
+
+  CompilePipeline(const CompilePipeline&) = delete;
+  CompilePipeline& operator=(const CompilePipeline&) = delete;
+
+  void submit(const std::vector<HyPas>& front, const std::vector<bool>& skipped = {});
+
+  // Blocks until candidate hfi of the current front is ready. hfi must be the index following
+  // the previously taken one (0 after submit), or following skipped candidates. The Programs
+  // returned write to mowri.
+  CompiledCandidate take(size_t hfi);
+
+  size_t get_n_cancelled() const;
+
+  private:
+  cl_device_id           device_id;
+  cl_context             context;
+  const Geometry         gg;
+  const oclutil::DevInfo devinfo;
+  size_t                 n_ahead;
+  owrite::Writer&        mowri;
+
+  mutable std::mutex      mut;
+  std::condition_variable cv_work;
+  std::condition_variable cv_ready;
+
+  std::vector<HyPas> front;
+  std::vector<bool>  skipped;
+  size_t             generation{0};
+  size_t             next_to_compile{0};
+  size_t             next_to_take{0};
+  size_t             n_cancelled{0};
+  bool               stopping{false};
+
+  std::map<size_t, CompiledCandidate> ready;
+  std::vector<std::thread>            workers;
+
+  void skip_to_compile();
+  void work();
+  CompiledCandidate compile(const HyPas& hp, owrite::Writer& worker_mowri) const;
+};
+}
+
+#endif
@@ -0,0 +1,56 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_COSTMODEL_HPP
+#define GUARD_MIOPENGEMM_COSTMODEL_HPP
+
+#include <string>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/hyperparams.hpp>
+#include <miopengemm/oclutil.hpp>
+
+namespace MIOpenGEMM
+{
+
+// The terms of a CostModel estimate, all times in [ms]
+class CostEstimate
+{
+  public:
+  // the time of the FMAs (of the padded problem), and of the LDS reads feeding them
+  double compute{0};
+  // the time to move A, B and C (and any workspace copies) through global memory
+  double memory{0};
+  // kernel launches
+  double overhead{0};
+  // flops per byte of global memory traffic
+  double intensity{0};
+
+  double get_time() const;
+  std::string get_string() const;
+};
+
+// An analytic roofline estimate of the time of a HyPas, computed on the CPU. Compute time
+// accounts for padding (macro tiles and unroll), the number of work groups relative to the
+// compute units and their occupancy, and micro tiles too small to hide LDS reads. Memory time
+// counts the A and B tiles read by every work group, C, and copies to workspace. Only relative
+// estimates are meaningful : the model is for ordering candidates, not predicting times.
+class CostModel
+{
+  public:
+  // peak_gflops and gbytes_per_second are derived from devinfo when 0, or if devinfo has no
+  // compute units or clock frequency, from a default (Fiji) device.
+  CostModel(const oclutil::DevInfo& devinfo, double peak_gflops = 0, double gbytes_per_second = 0);
+
+  // max() if hp is not derivable
+  CostEstimate get_estimate(const HyPas& hp, const Geometry& gg) const;
+  double       get_time(const HyPas& hp, const Geometry& gg) const;
+
+  private:
+  oclutil::DevInfo devinfo;
+  size_t           compute_units;
+  double           peak_gflops;
+  double           gbytes_per_second;
+};
+}
+
+#endif
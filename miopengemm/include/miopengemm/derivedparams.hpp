@@ -18,6 +18,9 @@ namespace MIOpenGEMM
 
 const size_t uninitialised_size_t = std::numeric_limits<size_t>::max();
 
+// the largest n for which the skinny kernel (GMV) is derivable
+const size_t max_n_skinny = 16;
+
 class Derivabilty
 {
   public:
@@ -26,6 +29,7 @@ class Derivabilty
   Derivabilty(const HyPas&, const Geometry&);
 };
 
+// same as Derivabilty(hp, gg).is_derivable, but no DerivedParams or strings are constructed.
 bool is_dvble(const HyPas&, const Geometry&);
 
 class ChiralDerivedParams
@@ -44,10 +48,15 @@ class ChiralDerivedParams
 
   // how many macro_lengths to cover m (a) or n (b)
   size_t n_groups = uninitialised_size_t;
+  // of which do not contain the final (ragged) tile
+  size_t n_interior_groups = uninitialised_size_t;
 
   // used when loading LDS -> registers, depends on MIW
   size_t main_c_interweave_stride;
 
+  // floats read from LDS into registers at a time, max(VEW, LRW). LDS is padded in its multiples
+  size_t main_lds_read_width = uninitialised_size_t;
+
   // copy to workspace specific parameters
   size_t cw_global_offset = uninitialised_size_t;
   size_t cw_n_elements    = uninitialised_size_t;
@@ -103,6 +112,12 @@ class DerivedParams
   // does the minimum setting to confirm compatibitily.
   std::tuple<bool, std::string> set_fragile();
 
+  private:
+  // set_fragile, when the main kernel is the skinny kernel (GMV)
+  std::tuple<bool, std::string> set_fragile_skinny();
+
+  public:
+
   size_t main_macro_tile_area = uninitialised_size_t;
   size_t main_micro_tile_area = uninitialised_size_t;
 
@@ -114,12 +129,40 @@ class DerivedParams
   size_t main_does_beta_c_inc         = uninitialised_size_t;
   size_t main_use_edge_trick          = uninitialised_size_t;
   size_t main_final_fractional_unroll = uninitialised_size_t;
+  // 2 if LDS is double buffered (DBL), otherwise 1
+  size_t main_n_lds_buffers = uninitialised_size_t;
+  // 1 if the splits in k (ICE) write partial tiles to workspace (DSK), otherwise 0
+  size_t main_split_on_k_partials = uninitialised_size_t;
+  // 1 if persistent work-groups share the (tile, unroll) iterations (GAL is STREAMK), otherwise 0
+  size_t main_stream_k               = uninitialised_size_t;
+  size_t main_sk_iterations_per_tile = uninitialised_size_t;
+  size_t main_sk_n_iterations        = uninitialised_size_t;
+  // 1 if the main kernel is the skinny kernel (GMV), otherwise 0. Its work items are in a grid
+  // along m and k, those along k are reduced at the end. A's macro tile is the rows of a work
+  // group, B's is all of n
+  size_t main_skinny               = uninitialised_size_t;
+  size_t skinny_n_work_items_pll_m = uninitialised_size_t;
+  size_t skinny_n_work_items_pll_k = uninitialised_size_t;
+  // 1 if the tiles of C on a ragged edge are processed by a separate kernel (IEK), otherwise 0.
+  // The work groups of MAIN are then those of the interior tiles, without bounds checks
+  size_t main_interior_edge    = uninitialised_size_t;
+  size_t edge_n_work_groups    = uninitialised_size_t;
+  size_t edge_global_work_size = uninitialised_size_t;
 
   // specific to scaling kernel, betac
   size_t betac_local_work_size = uninitialised_size_t;
   size_t betac_work_per_thread = uninitialised_size_t;
 
+  // specific to reduce kernel. After A and B in workspace, either one partial C per split in k
+  // (DSK) or two partial macro tiles per persistent work-group (Stream-K)
+  size_t reduce_local_work_size        = uninitialised_size_t;
+  size_t reduce_work_per_thread        = uninitialised_size_t;
+  size_t reduce_global_offset          = uninitialised_size_t;
+  size_t reduce_n_elements_per_partial = uninitialised_size_t;
+
   size_t cw2_n_macro_tiles_pll_unroll = uninitialised_size_t;
+  // 1 if both A and B use workspace, and one kernel prepares both (WSAB), otherwise 0
+  size_t prep_fused = uninitialised_size_t;
 
   // the int type for atomics
   std::string infa;
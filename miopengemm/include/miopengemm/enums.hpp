@@ -60,6 +60,31 @@ enum E
 const EnumMapper<std::string>& M();
 }
 
+// the strategy used to search the Graph in find
+namespace SearchType
+{
+enum E
+{
+  DESCENT = 0,
+  SURROGATE,
+  EVOLUTION,
+  N
+};
+const EnumMapper<std::string>& M();
+}
+
+// what a find over several geometries minimises
+namespace RobustObjective
+{
+enum E
+{
+  WEIGHTED_TIME = 0,  // the weighted sum of the times
+  WORST_SLOWDOWN,     // the largest time relative to the geometry's cached solution
+  N
+};
+const EnumMapper<std::string>& M();
+}
+
 namespace Xtr
 {
 enum E
@@ -82,12 +107,18 @@ enum E
   MIW,
   WOS,
   VEW,  // vector width
+  PRF,  // prefetch the next unroll from global memory into registers, during the math
+  LRW,  // LDS read width : max(VEW, LRW) floats are read from LDS into registers at a time
   N
 };
 const EnumMapper<std::string>& M();
 
 // prior weight on importance in graph
 const std::vector<int>& get_priority();
+
+// the values of hyper-parameters which may be omitted from a full hyper-string, such as those
+// added after the kernel cache was written. Status::E::UNDEFINED where they may not be omitted
+const std::vector<size_t>& get_omitted();
 }
 
 namespace NonChi
@@ -107,11 +138,19 @@ enum E
   SKW,      // skewness of work-item grid of work group
   AFI,      // do A loops and defs first. outerloops over a dimensions.
   MIA,      // work item allocation within workgroup : % or /
+  DBL,      // double buffer LDS : load the next unroll into LDS while computing this one
+  DSK,      // (if ICE != 1) deterministic split in k : partial tiles summed by a REDUCE kernel
+  PWG,      // (if GAL == 4) number of persistent work-groups, which share the tiles (Stream-K)
+  GMV,      // (if n is small) skinny kernel : A streamed, B in registers, no tiles in LDS
+  IEK,      // interior tiles (no bounds checks) and edge tiles of C in separate kernels
   N
 };
 const EnumMapper<std::string>& M();
 
 const std::vector<int>& get_priority();
+
+// the values of hyper-parameters which may be omitted from a full hyper-string
+const std::vector<size_t>& get_omitted();
 }
 
 namespace Mat
@@ -146,6 +185,7 @@ namespace Mat
 Mat::E                         mem_to_mat(Mem::E);
 const EnumMapper<std::string>* mat_to_xchi(Mat::E);
 const std::vector<int>*        mat_to_priority(Mat::E);
+const std::vector<size_t>*     mat_to_omitted(Mat::E);
 }
 
 namespace Status
@@ -178,9 +218,10 @@ namespace GroupAllocation
 {
 enum E
 {
-  BYROW = 1,
-  BYCOL = 2,
-  SUCOL = 3
+  BYROW   = 1,
+  BYCOL   = 2,
+  SUCOL   = 3,
+  STREAMK = 4
 };
 }
 
@@ -251,8 +292,11 @@ enum E
 {
   WSA = 0,
   WSB,
+  WSAB,    // WSA and WSB fused in one kernel, when both A and B use workspace
   BETAC,
   MAIN,
+  EDGE,    // the edge tiles of C, when MAIN only processes the interior tiles (IEK)
+  REDUCE,  // sums the partial tiles of MAIN in workspace into C (DSK)
   N  // how many KTypes
 };
 const EnumMapper<std::string>& M();
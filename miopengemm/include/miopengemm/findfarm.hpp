@@ -0,0 +1,134 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_FINDFARM_HPP
+#define GUARD_MIOPENGEMM_FINDFARM_HPP
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <miopengemm/findparams.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/hint.hpp>
+#include <miopengemm/hyperparams.hpp>
+#include <miopengemm/kernelcache.hpp>
+#include <miopengemm/outputwriter.hpp>
+
+namespace MIOpenGEMM
+{
+
+// A find to be run by the farm : a geometry and the constraints to find under.
+class FarmJob
+{
+  public:
+  Geometry    gg;
+  Constraints constraints;
+  FarmJob(const Geometry& gg, const Constraints& constraints);
+  std::string get_string() const;
+};
+
+// The outcome of a FarmJob. If is_found is false, message says why (the error thrown by find,
+// the signal which killed the worker, or a timeout).
+class FarmResult
+{
+  public:
+  FarmJob     job;
+  bool        is_found{false};
+  std::string device;
+  HyPas       hypas;
+  // [ms]
+  double      extime{0};
+  std::string message;
+  size_t      attempts{0};
+  // seconds, of the final attempt
+  double seconds{0};
+
+  FarmResult(const FarmJob& job_) : job(job_) {}
+};
+
+// The fastest HyPas found for each (device, constraints, geometry), with its time [ms].
+// Written as one tab-separated line per entry, so that runs of the farm merge into one database.
+class TuningDatabase
+{
+  public:
+  class Entry
+  {
+    public:
+    std::string device;
+    Constraints constraints;
+    Geometry    gg;
+    HyPas       hypas;
+    double      extime;
+    Entry(const std::string& device,
+          const Constraints& constraints,
+          const Geometry&    gg,
+          const HyPas&       hypas,
+          double             extime);
+  };
+
+  // returns true if the entry is new, or faster than the entry it replaces
+  bool add(const Entry& entry);
+  bool add(const FarmResult& result);
+  void merge(const TuningDatabase& other);
+
+  std::vector<Entry> get_entries() const;
+  size_t get_size() const { return entries.size(); }
+
+  // entries in canonical form, as the kernel cache stores them
+  KernelCache get_kernel_cache() const;
+  // kc.add(...) snippets, as written by find for pasting into the kernel cache
+  std::string get_cache_entries_string() const;
+
+  // written to a temporary file which is then renamed, so that path is always complete
+  void write(const std::string& path) const;
+
+  private:
+  std::map<std::string, Entry> entries;
+};
+
+// an empty database if path does not exist
+TuningDatabase read_tuning_database(const std::string& path);
+
+class FarmParams
+{
+  public:
+  // one worker per hint, each running one job at a time on its device
+  std::vector<CLHint> devices{CLHint()};
+  FindParams          find_params{get_at_least_n_seconds(10)};
+  // seconds, after which a worker is killed and its job failed (or retried)
+  double job_timeout{600};
+  // a job whose worker crashed or timed out is run again, up to max_attempts in total
+  size_t max_attempts{1};
+  // if not empty, the find output of job i is written to logdir + "job_i.txt"
+  std::string logdir;
+  // if not empty, results are merged into the database at database_path as they arrive
+  std::string database_path;
+  // if set, called in the worker process before the find of each job, to prepare its
+  // environment. An exception thrown fails the job
+  std::function<void(const FarmJob&)> worker_setup;
+};
+
+// Runs a queue of find jobs in worker processes, one per device of FarmParams. Each job is run in
+// a process of its own, so that a crashing or hanging find does not affect other jobs (or the
+// farm), and so that no OpenCL state is shared between jobs. The results are merged into one
+// TuningDatabase. Jobs are run by forking the calling process, which should not have created an
+// OpenCL context. On Windows, which has no fork, run throws.
+class FindFarm
+{
+  public:
+  FindFarm(const FarmParams& params, owrite::Writer& mowri);
+
+  // results are in the order of jobs
+  std::vector<FarmResult> run(const std::vector<FarmJob>& jobs);
+
+  const TuningDatabase& get_database() const { return database; }
+
+  private:
+  FarmParams      params;
+  owrite::Writer& mowri;
+  TuningDatabase  database;
+};
+}
+
+#endif
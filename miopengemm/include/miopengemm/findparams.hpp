@@ -5,6 +5,7 @@
 #define GUARD_MIOPENGEMM_FINDPARAMS_HPP
 
 #include <string>
+#include <tuple>
 #include <vector>
 #include <miopengemm/kernelstring.hpp>
 
@@ -29,6 +30,102 @@ class Halt
   std::string get_string() const;
 };
 
+// For racing candidates in find. A candidate's benchmark is abandoned once it has done min_runs
+// runs and the lower confidence bound of its time is more than margin slower than the
+// incumbent's. If batch_size > 1, the front is raced in batches of batch_size by successive
+// halving, and only the winner of each batch is benchmarked in full.
+class Racing
+{
+  public:
+  bool   enabled{false};
+  size_t min_runs{2};
+  double margin{0.05};
+  double z{2.0};
+  size_t batch_size{1};
+
+  Racing() = default;
+  Racing(size_t min_runs, double margin, double z, size_t batch_size);
+
+  // optimistic estimate of the time of a candidate : the lower confidence bound of the mean,
+  // but no more than the fastest run
+  double get_lower_bound(const std::vector<double>& times) const;
+  bool is_hopeless(const std::vector<double>& times, double incumbent) const;
+  std::string get_string() const;
+};
+
+// For timing on a noisy (shared) device. When disabled, a candidate is a new best if the summary
+// of its times is 0.2% less than the incumbent's. When enabled, warmup untimed launches precede
+// each benchmark, slow outliers are removed (see timingstats::remove_outliers), and a candidate
+// is a new best only if it is faster than the incumbent in a fraction confidence of bootstrap
+// resamples. If n_interleaved > 0, a candidate which appears faster is first run again against
+// the incumbent, n_interleaved runs each in Thue-Morse order, and only these runs are compared.
+class Noise
+{
+  public:
+  bool   enabled{false};
+  size_t warmup{2};
+  double outlier_k{3};
+  size_t n_interleaved{0};
+  double confidence{0.95};
+  size_t n_resamples{1000};
+
+  Noise() = default;
+  Noise(size_t warmup, double outlier_k, size_t n_interleaved, double confidence);
+
+  std::string get_string() const;
+};
+
+// For timing kernels too small for a single launch to be timed reliably, as launch overhead and
+// the granularity of event profiling are comparable to their time. If enabled, each timed run is
+// of back-to-back launches of the kernel chain, as many as needed (up to max_launches) for a run
+// to take at least min_run_time [ms], and its time is per launch.
+class Repeats
+{
+  public:
+  bool   enabled{false};
+  double min_run_time{0.5};
+  size_t max_launches{1000};
+
+  Repeats() = default;
+  Repeats(double min_run_time, size_t max_launches);
+
+  std::string get_string() const;
+};
+
+// For stopping find once searching further is not expected to pay for itself. The saving of a
+// kernel found is invocations x (default_time - its time), and the cost of search is its elapsed
+// time. Find halts when the saving of the best kernels found in the second half of the search so
+// far is less than the time that half took, or when the search has taken longer than all
+// invocations of the default would.
+class Amortisation
+{
+  public:
+  // the number of times the kernel is expected to run, 0 to disable
+  double invocations{0};
+  // [ms] the time of the default solution. If 0, find benchmarks the default solution
+  double default_time{0};
+  // [s] the search is never halted before this
+  double min_elapsed{1};
+
+  Amortisation() = default;
+  Amortisation(double invocations, double default_time);
+
+  bool is_enabled() const { return invocations > 0; }
+  // the best time [ms] found after elapsed [s]
+  void record(double elapsed, double best_time);
+  bool halt(double elapsed) const;
+  // [ms]
+  double get_best_time() const;
+  // the number of invocations needed for the saving to equal the cost of elapsed [s] of search
+  double get_break_even(double elapsed) const;
+  std::string get_string(double elapsed) const;
+
+  private:
+  // (elapsed, best time), in order of elapsed
+  std::vector<std::tuple<double, double>> history;
+  double get_best_time(double elapsed) const;
+};
+
 class FindParams
 {
   public:
@@ -40,6 +137,39 @@ class FindParams
 
   SummStat::E sumstat;
 
+  // number of candidates compiled on worker threads ahead of the one being benchmarked.
+  // if 0, each candidate is compiled just before it is benchmarked.
+  size_t n_compile_ahead{0};
+
+  // disabled by default
+  Racing racing;
+
+  // With DESCENT, hl_outer counts greedy descents. With a model-based search, it counts
+  // rounds of proposals (see SearchStrategy).
+  SearchType::E search{SearchType::E::DESCENT};
+
+  // the number of HyPas proposed per round of a model-based search (a generation of EVOLUTION)
+  size_t n_per_round{8};
+
+  // disabled by default
+  Noise noise;
+
+  // disabled by default
+  Repeats repeats;
+
+  // if enabled, find stops when further search is not expected to pay for itself
+  Amortisation amortisation;
+
+  // if true, a descent tries the neighbors of its best HyPas in the order of their time
+  // predicted by a CostModel, otherwise in a random order (see Graph::get_neighbors)
+  bool cost_ordered{true};
+
+  // if not empty, a FindCheckpoint is written to checkpoint_path every checkpoint_interval
+  // seconds and when find completes. If resume_path is not empty, find resumes from it.
+  std::string checkpoint_path;
+  double      checkpoint_interval{60};
+  std::string resume_path;
+
   FindParams(std::array<size_t, Xtr::E::N> descents,
              std::array<double, Xtr::E::N> time_outer,
              std::array<size_t, Xtr::E::N> per_kernel,
@@ -52,6 +182,11 @@ class FindParams
 
 FindParams get_at_least_n_seconds(double seconds);
 FindParams get_at_least_n_restarts(size_t restarts);
+
+// find for a kernel which will run invocations times, and whose default solution takes
+// default_time [ms] (0 if find should benchmark it) : find stops when searching further is not
+// expected to pay for itself, and after max_seconds at most.
+FindParams get_amortised(double invocations, double default_time, double max_seconds = 3600);
 }
 
 #endif
@@ -0,0 +1,20 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_FUSEDPREPGENERATOR_HPP
+#define GUARD_MIOPENGEMM_FUSEDPREPGENERATOR_HPP
+
+#include <miopengemm/basegenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace fusedprepgen
+{
+
+// when both A and B use workspace (WOS = COPY or NFORM), one kernel prepares both : the first
+// work groups run the copy / normal form kernel of A, the others that of B.
+KernBlob get_fused_prep_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+}
+}
+
+#endif
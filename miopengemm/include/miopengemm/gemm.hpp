@@ -112,6 +112,59 @@ GemmStatus xgemm(bool              isColMajor,
                  cl_event*         ptr_event,
                  int               ID);
 
+/*! @brief
+ * A chain of GEMMs of the same geometry, in a single launch of a persistent kernel.
+ * - for i = 0 ... n_chain - 1 : \f$ C_i \leftarrow \alpha op(A_i) op(B_i) + \beta C_i \f$
+ * where the offsets of \f$ A_i, B_i, C_i \f$ are a_offset + chain_table[3i],
+ * b_offset + chain_table[3i + 1] and c_offset + chain_table[3i + 2].
+ * Problem i starts when problem i - 1 is complete, so \f$ C_{i-1} \f$ can be \f$ A_i \f$ or
+ * \f$ B_i \f$, as with the timesteps of an RNN. A buffer which is written by a problem should
+ * not be read by an earlier problem of the chain.
+ * The problems are ordered with OpenCL 2.0 device scope atomics. On a device without them,
+ * the problems are run with xgemm's kernels, one launch per problem.
+ * The other parameters are as for xgemm, with zero workspace.
+ *
+ * @param chain_table
+ * memory buffer of 3*n_chain cl_ulong, the offsets of the problems
+ *
+ * @param chain_state
+ * memory buffer of (at least) n_chain cl_int, used to order the problems. It is overwritten
+ * (unused when the problems are run one launch per problem)
+ *
+ * @param n_chain
+ * The number of problems in the chain
+ *
+ * @param ID
+ * As for xgemm, but IDs of xgemm_chain and xgemm are not interchangeable
+ */
+
+template <typename T>
+GemmStatus xgemm_chain(bool              isColMajor,
+                       bool              tA,
+                       bool              tB,
+                       size_t            m,
+                       size_t            n,
+                       size_t            k,
+                       T                 alpha,
+                       cl_mem            a,
+                       size_t            a_offset,
+                       size_t            lda,
+                       cl_mem            b,
+                       size_t            b_offset,
+                       size_t            ldb,
+                       T                 beta,
+                       cl_mem            c,
+                       size_t            c_offset,
+                       size_t            ldc,
+                       cl_mem            chain_table,
+                       cl_mem            chain_state,
+                       size_t            n_chain,
+                       cl_command_queue* ptr_queue,
+                       cl_uint           num_events_in_wait_list,
+                       const cl_event*   event_wait_list,
+                       cl_event*         ptr_event,
+                       int               ID);
+
 /*! @brief
  * GEneral Matric Multiplication.
  * - \f$ C \leftarrow \alpha op(A) op(B) + \beta C \f$
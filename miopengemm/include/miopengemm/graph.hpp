@@ -8,6 +8,7 @@
 #include <functional>
 #include <map>
 #include <vector>
+#include <miopengemm/costmodel.hpp>
 #include <miopengemm/error.hpp>
 #include <miopengemm/geometry.hpp>
 #include <miopengemm/hyperparams.hpp>
@@ -111,8 +112,11 @@ class Graph
   Graph(const Geometry&, const oclutil::DevInfo&, const Constraints&, owrite::Writer&);
   // any node in the start graph.
   HyPas              get_random_valid_start() const;
-  std::vector<HyPas> get_neighbors(const HyPas&, bool prioritize) const;
+  // In a random order, by priority of the hyper-parameter changed if prioritize. If cost_ordered,
+  // by the time predicted by a CostModel (fastest first) instead.
+  std::vector<HyPas> get_neighbors(const HyPas&, bool prioritize, bool cost_ordered = false) const;
   bool contains(const HyPas&) const;
+  bool contains(Mat::E, size_t hpi, size_t value) const;
 
   private:
   // the number of attempts at finding a
@@ -130,6 +134,7 @@ class Graph
 
   Geometry         geometry;
   oclutil::DevInfo devinfo;
+  CostModel        cost_model;
   Constraints      constraints;
   owrite::Writer&  mowri;  // this makes Graphs difficult to copy.
 
@@ -141,9 +146,11 @@ class Graph
   // any node in the start graph.
   HyPas get_random_start() const;
   void  checks() const;
-
-  bool contains(Mat::E, size_t hpi, size_t value) const;
 };
+
+// The state of the random number generator shared by Graph neighbors and starts
+std::string get_graph_random_state();
+void        set_graph_random_state(const std::string& state);
 }
 
 #endif
@@ -64,14 +64,38 @@ class KernelCache
   std::vector<CacheKey> get_keys() const;
 
   std::string get_cache_entry_string(const CacheKey& ck) const;
+
+  size_t get_size() const { return vals.size(); }
+  // approximate number of bytes of heap and stack used by the entries
+  size_t get_memory_estimate() const;
+};
+
+// load-time instrumentation of a kernel cache shard
+class KernelCacheShardStats
+{
+  public:
+  std::string device;
+  char        floattype;
+  size_t      n_entries;
+  size_t      n_bytes;
+  // seconds
+  double load_time;
+  std::string get_string() const;
 };
 
 void filter_device(std::vector<CacheKey>&, const std::vector<std::string>& device_frags);
 void filter_geometries(std::vector<CacheKey>&, const std::vector<Geometry>& geometries);
 void filter_floattype(std::vector<CacheKey>&, size_t);
 
+// all entries, for all devices and float types. Only for tools which inspect the whole cache.
 const KernelCache& get_kernel_cache();
 
+// entries for one device and float type ('f' or 'd'), loaded the first time it is requested.
+const KernelCache& get_kernel_cache(const std::string& device, char floattype);
+
+// stats of all shards loaded so far, including the full cache if it has been loaded.
+std::vector<KernelCacheShardStats> get_kernel_cache_shard_stats();
+
 std::string get_cache_entry_string(const CacheKey& ck, const HyPas& hypas, bool swap_ab);
 std::vector<Geometry> get_geometries(const std::vector<CacheKey>& cks);
 std::vector<std::string> get_devices(const std::vector<CacheKey>& cks);
@@ -31,6 +31,9 @@ const size_t skew0 = 10;
 // return true if power of 4.
 bool mac_is_square(size_t mac);
 
+// as Grid, but without constructing any error message. returns true if Grid would be good.
+bool get_grid(size_t mac, size_t skew, size_t& grid_A, size_t& grid_B);
+
 class Grid
 {
 
@@ -35,7 +35,9 @@ namespace MIOpenGEMM
  * Matric C, memory will be unchanged
  *
  * @param enforce_determinism
- * If true, only kernels which are bitwise consistent are considered. Specifically, ICE=1.
+ * If true, only kernels which are bitwise consistent are considered. Specifically, ICE=1 if
+ * tgg.wSpaceSize is 0, otherwise kernels which split in k reduce their partials in workspace
+ * (DSK=1). A workspace of tgg.wSpaceSize is allocated for the find.
  * For small m*n, enforce_determinism = false will find faster Solutions.
  *
  * @param tgg
@@ -66,6 +68,12 @@ Solution find(float            allotted_time,
  */
 HyPas get_generic(const Geometry& gg, const Constraints& constraints);
 
+/*! @brief
+ * Whether n is small enough for the skinny kernel (GMV), and the constraints do not exclude it.
+ * get_generic returns the skinny kernel for such problems
+ */
+bool is_skinny(const Geometry& gg, const Constraints& constraints);
+
 /*! @brief
  * Find and return a Solution which matches well the device and Geometry,
  * without performing any compiling-benchmarking.
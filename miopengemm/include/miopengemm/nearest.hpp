@@ -21,6 +21,28 @@ bool is_within(
 
 // of all the CacheKeys in the KernelCache, return the {rank} nearest satisfying (1) and (2) above.
 CacheKey get(const CacheKey&, const Graph&, const KernelCache&, size_t rank);
+
+class Interpolated
+{
+  public:
+  bool        is_interpolated;
+  HyPas       hp;
+  std::string msg;
+  Interpolated(const std::string& msg_) : is_interpolated(false), msg(msg_) {}
+  Interpolated(const HyPas& hp_, const std::string& msg_)
+    : is_interpolated(true), hp(hp_), msg(msg_)
+  {
+  }
+};
+
+// find the two CacheKeys in the KernelCache which bracket ck_in along one of m, n, k
+// (same device, constraints, transposes, float type, workspace, other two dimensions, and ldX
+// paddings and alignments), and combine their HyPas. For each hyper-parameter on which the
+// brackets disagree, the value interpolated (log-linearly in the dimension) between the
+// brackets' values is used, if it is in graph and remains derivable. Otherwise the nearer
+// bracket's value is kept. Not interpolated if a cache entry is near ck_in (see get above), or if
+// no value is interpolated. hp returned is for canonical ck_in.gg, as is the case with get above.
+Interpolated get_interpolated(const CacheKey& ck_in, const Graph&, const KernelCache&);
 }
 }
 
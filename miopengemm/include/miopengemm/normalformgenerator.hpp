@@ -4,6 +4,7 @@
 #ifndef GUARD_MIOPENGEMM_NORMALFORMGENERATOR_HPP
 #define GUARD_MIOPENGEMM_NORMALFORMGENERATOR_HPP
 
+#include <memory>
 #include <miopengemm/derivedparams.hpp>
 #include <miopengemm/geometry.hpp>
 #include <miopengemm/kernelstring.hpp>
@@ -16,6 +17,10 @@ namespace nformgen
 
 KernBlob
 get_nform_kernelstring(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+
+// set up, for the kernel of A and B fused
+std::unique_ptr<prepgen::PrepGenerator>
+get_nform_generator(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
 }
 }
 
@@ -106,6 +106,19 @@ Result cl_enqueue_copy_buffer(cl_command_queue   command_queue,
                               const std::string& hash,
                               bool               strict);
 
+// OpenCL 1.2
+Result cl_enqueue_fill_buffer(cl_command_queue   command_queue,
+                              cl_mem             buffer,
+                              const void*        pattern,
+                              size_t             pattern_size,
+                              size_t             offset,
+                              size_t             size,
+                              cl_uint            num_events_in_wait_list,
+                              const cl_event*    event_wait_list,
+                              cl_event*          event,
+                              const std::string& hash,
+                              bool               strict);
+
 Result cl_release_mem_object(cl_mem memobj, const std::string& hash, bool strict);
 
 Result cl_enqueue_ndrange_kernel(cl_command_queue   command_queue,
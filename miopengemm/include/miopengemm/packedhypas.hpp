@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_PACKEDHYPAS_HPP
+#define GUARD_MIOPENGEMM_PACKEDHYPAS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <miopengemm/enums.hpp>
+#include <miopengemm/hyperparams.hpp>
+
+namespace MIOpenGEMM
+{
+
+namespace packing
+{
+// number of bits used to store each hyper-parameter, values must be less than 2^bits.
+// these leave some headroom above the largest values in the Graph.
+constexpr size_t chi_bits[Chi::E::N] = {
+  5,  // MIC
+  2,  // PAD
+  1,  // PLU
+  1,  // LIW
+  1,  // MIW
+  2,  // WOS
+  4,  // VEW
+  1,  // PRF
+  3   // LRW
+};
+
+constexpr size_t non_chi_bits[NonChi::E::N] = {
+  9,   // UNR
+  3,   // GAL
+  1,   // PUN
+  6,   // ICE
+  1,   // IWI
+  1,   // SZT
+  1,   // MAD
+  8,   // NAW
+  1,   // UFO
+  10,  // MAC
+  5,   // SKW
+  1,   // AFI
+  1,   // MIA
+  1,   // DBL
+  1,   // DSK
+  10,  // PWG
+  1,   // GMV
+  1    // IEK
+};
+
+// position of the first bit of hyper-parameter hpi
+constexpr size_t get_offset(const size_t* bits, size_t hpi)
+{
+  return hpi == 0 ? 0 : bits[hpi - 1] + get_offset(bits, hpi - 1);
+}
+
+static_assert(get_offset(chi_bits, Chi::E::N) <= 64, "Chi hyper-parameters do not fit in 64 bits");
+static_assert(get_offset(non_chi_bits, NonChi::E::N) <= 64,
+              "NonChi hyper-parameters do not fit in 64 bits");
+
+constexpr const size_t* get_bits(Mat::E emat)
+{
+  return emat == Mat::E::C ? non_chi_bits : chi_bits;
+}
+}
+
+// HyPas with each SuHy packed into a single 64-bit word. Unlike HyPas,
+// copying, comparing and hashing do not allocate or loop over vectors.
+class PackedHyPas
+{
+  public:
+  std::array<uint64_t, Mat::E::N> words;
+
+  PackedHyPas() : words{{0, 0, 0}} {}
+  PackedHyPas(const HyPas&);
+  // from the concatenated form, A_MIC4_PAD1_..__B_MIC2_..__C_UNR16_..
+  PackedHyPas(const std::string&);
+
+  size_t at(Mat::E emat, size_t hpi) const
+  {
+    const size_t* bits = packing::get_bits(emat);
+    return (words[emat] >> packing::get_offset(bits, hpi)) & ((uint64_t(1) << bits[hpi]) - 1);
+  }
+
+  void set(Mat::E emat, size_t hpi, size_t value);
+
+  HyPas get_hypas() const;
+  // the concatenated form, as accepted by the string constructor
+  std::string get_string() const;
+
+  bool operator==(const PackedHyPas& rhs) const { return words == rhs.words; }
+  bool operator!=(const PackedHyPas& rhs) const { return words != rhs.words; }
+};
+
+class PackedHyPasHash
+{
+  public:
+  size_t operator()(const PackedHyPas& php) const;
+};
+}
+
+#endif
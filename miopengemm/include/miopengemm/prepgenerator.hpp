@@ -21,7 +21,7 @@ class PrepGenerator : public basegen::BaseGenerator
   char   MCHAR;
   char   mchar;
 
-  virtual void set_usage() override final;
+  virtual void set_usage() override;
   void append_basic_what_definitions(std::stringstream& ss);
 
   size_t get_global_work_size()
@@ -30,9 +30,26 @@ class PrepGenerator : public basegen::BaseGenerator
     return forall_global_work_size;
   }
 
+  // the work groups of this kernel start at this group id. Non-zero for B, when fused with A
+  size_t group_id_offset = 0;
+  std::string get_group_id_string();
+
   public:
   virtual ~PrepGenerator() = default;
   PrepGenerator(Mat::E emat_x, const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_);
+
+  // the kernel is its definitions (macros), and a function which the kernel of A and B fused
+  // (see fusedprepgenerator) calls with the group id offset
+  virtual void append_definitions(std::stringstream& ss) = 0;
+  virtual void append_body(std::stringstream& ss)        = 0;
+  void append_function(std::stringstream& ss);
+  void append_call(std::stringstream& ss);
+
+  void set_group_id_offset(size_t offset) { group_id_offset = offset; }
+  size_t get_prep_n_work_groups() { return get_n_work_groups(); }
+  size_t get_prep_local_work_size() { return get_local_work_size(); }
+
+  virtual KernBlob get_kernelstring() override final;
 };
 }
 }
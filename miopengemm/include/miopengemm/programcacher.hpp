@@ -44,6 +44,9 @@ class ProgramCacher
   public:
   std::array<Programs, max_cache_size> program_cache;  // 7MB @ max_cache_size = 10000.
   std::array<HyPas, max_cache_size>    hyper_params;
+  // if false for a chain ID, the device does not support the chain kernel, and the programs are
+  // the usual kernels, to be run once per problem
+  std::array<bool, max_cache_size> chain_kernels;
 
   std::unordered_map<std::string, int> IDs;
   std::mutex mutt;
@@ -61,9 +64,12 @@ class ProgramCacher
              size_t            w_size,
              BetaType          beta_type,
              char              floattype,
-             cl_command_queue* ptr_queue);
+             cl_command_queue* ptr_queue,
+             bool              chain = false);
 
   int get_ID_from_geom(const Geometry& gg, BetaType beta, cl_command_queue* ptr_queue);
+
+  // if chain, the ID is of a single persistent main kernel for chains of problems (xgemm_chain)
 };
 
 ProgramCacher& get_cacher();
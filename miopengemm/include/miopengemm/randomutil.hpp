@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <random>
+#include <string>
 #include <miopengemm/error.hpp>
 
 namespace MIOpenGEMM
@@ -23,6 +24,9 @@ class RandomUtil
   RandomUtil();
   RandomUtil(int seed);
   size_t get_from_range(size_t upper);
+  // the state of the generator, for resuming a sequence with set_state
+  std::string get_state() const;
+  void        set_state(const std::string& state);
   template <typename T>
   void shuffle(size_t start_index, size_t end_index, T& t)
   {
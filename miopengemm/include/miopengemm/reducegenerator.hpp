@@ -0,0 +1,43 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_REDUCEGENERATOR_HPP
+#define GUARD_MIOPENGEMM_REDUCEGENERATOR_HPP
+
+#include <sstream>
+#include <miopengemm/bylinegenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace reducegen
+{
+
+class ReduceGenerator : public bylinegen::ByLineGenerator
+{
+
+  private:
+  // reads the partial tiles in workspace, as well as C
+  virtual void set_usage() override final;
+
+  public:
+  virtual ~ReduceGenerator() = default;
+  ReduceGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_);
+
+  virtual void setup_additional() override final;
+
+  virtual void set_type() override final;
+
+  virtual void append_derived_definitions_additional(std::stringstream& ss) override final;
+
+  size_t get_local_work_size() override final;
+
+  size_t get_work_per_thread() override final;
+
+  virtual KType::E get_ktype() override final;
+};
+
+KernBlob get_reduce_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+}
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_ROBUSTFIND_HPP
+#define GUARD_MIOPENGEMM_ROBUSTFIND_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <miopengemm/enums.hpp>
+#include <miopengemm/findparams.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/hint.hpp>
+#include <miopengemm/hyperparams.hpp>
+#include <miopengemm/oclutil.hpp>
+#include <miopengemm/outputwriter.hpp>
+#include <miopengemm/tinytwo.hpp>
+
+namespace MIOpenGEMM
+{
+
+// One HyPas for a set of geometries, with its time on each.
+class RobustSolution
+{
+  public:
+  HyPas                 hypas;
+  std::vector<Geometry> geometries;
+  // [ms]
+  std::vector<double> times;
+  // [ms], of the cached solution of each geometry
+  std::vector<double> reference_times;
+  double              objective;
+  std::string         device;
+  Constraints         constraints;
+
+  RobustSolution(const std::string& device, const Constraints& constraints);
+  double get_worst_slowdown() const;
+  // an entry for each geometry, all with hypas, so that geometries of the range (and those
+  // nearest to them) get the same kernel family
+  std::string get_cache_entries_string() const;
+};
+
+namespace dev
+{
+
+// Finds a HyPas for a set of geometries, derivable for them all, which minimises the weighted
+// total time or the worst slowdown relative to the cached solutions. The geometries should only
+// differ in their sizes (m, n, k, ld's) : the search is over the Graph of the geometry with the
+// most weighted flops. Every candidate is benchmarked on every geometry, with fparms.hl_core,
+// and greedy descents restart until fparms.hl_outer halts.
+class RobustFind
+{
+  public:
+  RobustFind(const std::vector<Geometry>& geometries,
+             const std::vector<double>&   weights,
+             owrite::Writer&              mowri,
+             const CLHint&                xhint);
+
+  RobustSolution
+  find(const FindParams& fparms, const Constraints& constraints, RobustObjective::E objective);
+
+  private:
+  std::vector<Geometry>                 geometries;
+  std::vector<double>                   weights;
+  owrite::Writer&                       mowri;
+  // the benchmarks of candidates are not written
+  owrite::Writer                        silent_mowri{Ver::E::SILENT, ""};
+  oclutil::DevInfo                      devinfo;
+  std::vector<std::unique_ptr<TinyTwo>> tinytwos;
+  // the geometry whose Graph is searched
+  size_t dominant{0};
+
+  bool is_derivable(const HyPas& hp) const;
+  // [ms] on each geometry, empty if hp fails on any of them
+  std::vector<double> get_times(const HyPas& hp, const Halt& hl, SummStat::E sumstat);
+  double get_objective(const std::vector<double>& times,
+                       const std::vector<double>& reference_times,
+                       RobustObjective::E         objective) const;
+};
+}
+}
+
+#endif
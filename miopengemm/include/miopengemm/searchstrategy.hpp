@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_SEARCHSTRATEGY_HPP
+#define GUARD_MIOPENGEMM_SEARCHSTRATEGY_HPP
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <miopengemm/enums.hpp>
+#include <miopengemm/geometry.hpp>
+#include <miopengemm/graph.hpp>
+#include <miopengemm/hyperparams.hpp>
+#include <miopengemm/packedhypas.hpp>
+#include <miopengemm/randomutil.hpp>
+
+namespace MIOpenGEMM
+{
+
+// A model-based search of the Graph. find alternates between propose, which returns HyPas
+// to benchmark, and observe, which reports each benchmark's time. Proposed HyPas are
+// derivable, in the Graph, and never proposed twice.
+class SearchStrategy
+{
+  public:
+  virtual ~SearchStrategy() = default;
+
+  // at most n HyPas. Returns fewer (or none) if the strategy has nothing left to try.
+  virtual std::vector<HyPas> propose(size_t n) = 0;
+
+  // time [ms], std::numeric_limits<double>::max() if the HyPas failed to compile or run.
+  virtual void observe(const HyPas& hp, double time) = 0;
+};
+
+// The HyPas which a strategy may propose : derivable, in the Graph and not already proposed.
+bool is_proposable(const HyPas&                                            hp,
+                   const Graph&                                            graph,
+                   const Geometry&                                         gg,
+                   const std::unordered_set<PackedHyPas, PackedHyPasHash>& proposed);
+
+// Features of HyPas and Geometry for models : log2(1 + value) of each hyper parameter,
+// followed by log2 of m, n and k.
+std::vector<double> get_features(const HyPas& hp, const Geometry& gg);
+
+// A Gaussian process surrogate of log time, over the features of evaluated HyPas. Proposes
+// the HyPas with the largest expected improvement, from the neighbors of the best evaluated
+// HyPas and random valid starts. The first proposals are the seeds.
+class SurrogateSearch : public SearchStrategy
+{
+  public:
+  SurrogateSearch(const Graph& graph, const Geometry& gg, const std::vector<HyPas>& seeds);
+
+  std::vector<HyPas> propose(size_t n) override;
+  void               observe(const HyPas& hp, double time) override;
+
+  private:
+  const Graph&       graph;
+  const Geometry     gg;
+  std::vector<HyPas> seeds;
+
+  std::unordered_set<PackedHyPas, PackedHyPasHash> proposed;
+
+  std::vector<HyPas>               x_hps;
+  std::vector<std::vector<double>> x_features;
+  std::vector<double>              times;
+
+  // the fitted model, over the training indices
+  std::vector<size_t>              train;
+  std::vector<std::vector<double>> chol;
+  std::vector<double>              alpha;
+  double                           y_mean{0};
+  double                           y_scale{1};
+  double                           y_best{0};
+
+  bool   try_propose(const HyPas& hp, std::vector<HyPas>& proposals);
+  void   fit();
+  double get_expected_improvement(const std::vector<double>& features) const;
+};
+
+// A genetic search. Each round is a generation of children of the population (the fastest
+// evaluated HyPas), with parents chosen by tournament. A child is a crossover of its parents'
+// SuHy blocks, a mutation (a random Graph neighbor, so a one-away, p-coupled or mic-mac move)
+// of a parent, or both. Children which are not derivable are repaired by mutation. The times
+// of evaluated HyPas are cached, and nothing is proposed twice.
+class EvolutionarySearch : public SearchStrategy
+{
+  public:
+  EvolutionarySearch(const Graph&              graph,
+                     const Geometry&           gg,
+                     const std::vector<HyPas>& seeds,
+                     size_t                    population_size);
+
+  std::vector<HyPas> propose(size_t n) override;
+  void               observe(const HyPas& hp, double time) override;
+
+  private:
+  const Graph&       graph;
+  const Geometry     gg;
+  std::vector<HyPas> seeds;
+  size_t             population_size;
+  RandomUtil         radutil;
+
+  std::unordered_set<PackedHyPas, PackedHyPasHash>         proposed;
+  std::unordered_map<PackedHyPas, double, PackedHyPasHash> evaluated;
+
+  // sorted by time, fastest first
+  std::vector<HyPas> population;
+
+  bool         try_propose(const HyPas& hp, std::vector<HyPas>& proposals);
+  const HyPas& get_tournament_winner();
+  HyPas        get_crossover(const HyPas& hp0, const HyPas& hp1);
+  // a random derivable neighbor of hp in the Graph, false if there is none
+  bool set_mutated(const HyPas& hp, HyPas& mutant);
+};
+
+std::unique_ptr<SearchStrategy> get_search_strategy(SearchType::E             search,
+                                                    const Graph&              graph,
+                                                    const Geometry&           gg,
+                                                    const std::vector<HyPas>& seeds);
+}
+
+#endif
@@ -0,0 +1,22 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_SKINNYGENERATOR_HPP
+#define GUARD_MIOPENGEMM_SKINNYGENERATOR_HPP
+
+#include <miopengemm/basegenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace skinnygen
+{
+
+// the main kernel when GMV is yes, for small n (matrix-vector and small batch) : bandwidth bound,
+// so without LDS tiles. Each work item streams MIC rows of A with loads of VEW elements, keeping
+// the corresponding rows of B (all n columns) in registers. Work items along k (the B dimension
+// of the MAC/SKW grid) reduce their partial sums in LDS before writing C.
+KernBlob get_skinny_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+}
+}
+
+#endif
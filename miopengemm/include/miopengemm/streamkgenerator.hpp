@@ -0,0 +1,21 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_STREAMKGENERATOR_HPP
+#define GUARD_MIOPENGEMM_STREAMKGENERATOR_HPP
+
+#include <miopengemm/basegenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace streamkgen
+{
+
+// the fix-up kernel of Stream-K (GAL STREAMK) : one work group per tile of C. The tiles which
+// more than one persistent work group processed are completed, by summing the partial tiles
+// in workspace in a fixed order, so that the result is deterministic.
+KernBlob get_stream_k_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp);
+}
+}
+
+#endif
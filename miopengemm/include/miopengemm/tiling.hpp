@@ -42,6 +42,12 @@ void set_tile_dimensions(size_t& tH, size_t& tW, size_t TH, size_t TW, size_t tS
 // checks if it is tileable according to the above.
 // returns (true, "") if, otherwise (false,"reason")
 std::tuple<bool, std::string> get_tileability(size_t TH, size_t TW, size_t tS);
+
+// as get_tileability, but never throws or allocates. Cases where get_tileability throws are false.
+bool is_tileable(size_t TH, size_t TW, size_t tS);
+
+// as set_tile_dimensions with tall = true, without any checks. tH is 0 if not tileable.
+void set_tile_dimensions_no_checks(size_t& tH, size_t& tW, size_t TH, size_t TW, size_t tS);
 }
 }
 
@@ -0,0 +1,54 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#ifndef GUARD_MIOPENGEMM_TIMINGSTATS_HPP
+#define GUARD_MIOPENGEMM_TIMINGSTATS_HPP
+
+#include <string>
+#include <vector>
+#include <miopengemm/enums.hpp>
+
+namespace MIOpenGEMM
+{
+namespace timingstats
+{
+
+// the summary of benchmark times [ms]. MAX is of gflops, so it is the minimum time
+double get_summary(const std::vector<double>& times, SummStat::E sumstat);
+
+// sequence for a fair penalty shoot-out, ABBABAAB...
+std::vector<bool> get_thue_morse(size_t length);
+
+// times more than k (scaled) median absolute deviations above the median, as caused by other
+// work on the device. Only slow outliers are removed, and none if k is 0 or there are fewer
+// than 3 times.
+std::vector<double> remove_outliers(const std::vector<double>& times, double k);
+
+// A percentile bootstrap confidence interval of a summary of times [ms]
+class Interval
+{
+  public:
+  double lower;
+  double estimate;
+  double upper;
+  std::string get_string() const;
+};
+
+// resamples are drawn from a generator seeded with seed, so that intervals are reproducible
+Interval get_bootstrap_interval(const std::vector<double>& times,
+                                SummStat::E                sumstat,
+                                double                     confidence,
+                                size_t                     n_resamples,
+                                unsigned                   seed = 0);
+
+// the fraction of bootstrap resamples in which the summary of challenger is smaller than that of
+// incumbent, ie the confidence that challenger is faster
+double get_confidence_faster(const std::vector<double>& challenger,
+                             const std::vector<double>& incumbent,
+                             SummStat::E                sumstat,
+                             size_t                     n_resamples,
+                             unsigned                   seed = 0);
+}
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <memory>
 #include <stdlib.h>
 #include <string>
+#include <tuple>
 #include <vector>
 #include <miopengemm/geometry.hpp>
 #include <miopengemm/solution.hpp>
@@ -43,8 +44,14 @@ class TinyOne
 
   Solution find1(const FindParams& find_params, const Constraints& constraints);
 
+  // of the last find1, (elapsed [s], time [ms]) at each new best solution
+  std::vector<std::tuple<double, double>> get_best_path() const;
+
   void accuracy_test(const HyPas& hp);  //, const TFloat* c_true_for_test);
 
+  // c as computed on the device by the last accuracy_test
+  const std::vector<TFloat>& get_c_copy() const { return c_copy; }
+
   private:
   Geometry gg;
   Offsets  toff;
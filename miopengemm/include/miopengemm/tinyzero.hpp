@@ -15,6 +15,8 @@
 #include <vector>
 #include <miopengemm/architests.hpp>
 #include <miopengemm/bundle.hpp>
+#include <miopengemm/checkpoint.hpp>
+#include <miopengemm/compilepipeline.hpp>
 #include <miopengemm/derivedparams.hpp>
 #include <miopengemm/error.hpp>
 #include <miopengemm/findparams.hpp>
@@ -24,6 +26,7 @@
 #include <miopengemm/oclutil.hpp>
 #include <miopengemm/outputwriter.hpp>
 #include <miopengemm/programs.hpp>
+#include <miopengemm/searchstrategy.hpp>
 #include <miopengemm/solution.hpp>
 #include <miopengemm/stringutilbase.hpp>
 #include <miopengemm/timer.hpp>
@@ -37,16 +40,36 @@ class FindTracker
 
   private:
   Timer  timer;
+  double elapsed_before{0};
   size_t descents{0};
   size_t kernels{0};
+  size_t raced_out{0};
+  double race_saving{0};
+  // candidates which failed the architests, so were not compiled
+  size_t avoided{0};
 
   public:
   void        start();
   void        incr_descents();
   void        incr_kernels();
+  void        incr_avoided();
+  void        add_race_saving(double seconds);
   double      get_elapsed() const;
   size_t      get_descents() const;
   std::string get_string() const;
+
+  // the counts and elapsed time, for resuming a find with set_state
+  std::string get_state() const;
+  void        set_state(const std::string& state);
+};
+
+// The outcome of racing a candidate in true_core. saving is the estimated time [s] which
+// benchmarking until Halt would have taken, less the time taken.
+class RaceStat
+{
+  public:
+  bool   abandoned{false};
+  double saving{0};
 };
 
 // For bundling the 4 GPU memories (a, b, c, w), and managing the copy of c if it is needed
@@ -87,6 +110,9 @@ class TinyZero
   std::vector<double> benchgemm(const HyPas& hp, const Halt& hl);
   Solution find0(const Constraints& constraint, const FindParams& find_params);
 
+  // of the last find, (elapsed [s], time [ms]) at each new best solution
+  const std::vector<std::tuple<double, double>>& get_best_path() const { return best_path; }
+
   private:
   cl_command_queue       command_queue;
   const Geometry         gg;
@@ -98,6 +124,48 @@ class TinyZero
   Programs    programs;
   KernelTimes kernel_times{};
 
+  // the state of the current find, for checkpointing
+  FindCheckpoint checkpoint;
+  std::string    checkpoint_path;
+  double         checkpoint_interval;
+  double         checkpoint_last{0};
+  // only a resumed find reuses the times recorded in checkpoint
+  bool is_resumed{false};
+
+  // of the current find, with the time of the default solution set
+  Amortisation amortisation;
+  // the amortised halt only applies once a solution is found, so that find returns one
+  bool is_amortisation_halted(const FindTracker& ftrack, bool found) const;
+  // the default solution, with the time of amortisation, for a find which halts before finding
+  Solution get_amortisation_default(const Constraints& constraints);
+
+  // of the current find, see get_best_path
+  std::vector<std::tuple<double, double>> best_path;
+  void record_best(double elapsed, double extime);
+
+  // of the current find, for the untimed launches of true_core and deciding new bests
+  Noise noise;
+  // of the current descent (or strategy find) with noise control, the times of the incumbent
+  // (outliers removed), and its programs if challengers are interleaved with it
+  std::vector<double> incumbent_times;
+  Programs            incumbent_programs;
+  size_t get_n_warmup() const { return noise.enabled ? noise.warmup : 0; }
+
+  // of the current find, for the number of launches per timed run
+  Repeats repeats;
+
+  // Enqueues n_launches back-to-back launches of programs, the last with its kernel times in
+  // kernel_times. If n_launches > 1, kernel_times.extime is the time per launch, from the end of
+  // the first launch to the end of the last, so that whole chains (with copy kernels) are timed.
+  oclutil::Result run_launches(const AllKernArgs& all_kern_args, size_t n_launches);
+
+  // The number of launches for a run of programs to take repeats.min_run_time (1 if repeats is
+  // not enabled), found by timing runs of increasing numbers of launches.
+  size_t get_n_launches(const AllKernArgs& all_kern_args);
+
+  // writes the checkpoint if checkpoint_interval has passed since the last write, or if force
+  void update_checkpoint(const FindTracker& ftrack, bool force);
+
   double get_gflops(double timems);
   std::string get_run_times_heading();
   std::string get_run_time_string(cl_int status);
@@ -106,16 +174,80 @@ class TinyZero
 
   Solution single_descent_find(double allotted_time,
                                const Constraints&,
-                               const Halt&  core_hl,
-                               FindTracker& ftrack,
-                               SummStat::E  sumstat,
-                               bool         warmstart,
-                               size_t       warmstart_rank);
+                               const Halt&   core_hl,
+                               FindTracker&  ftrack,
+                               SummStat::E   sumstat,
+                               bool          warmstart,
+                               size_t        warmstart_rank,
+                               size_t        n_compile_ahead,
+                               const Racing& racing,
+                               bool          cost_ordered);
 
+  // If racing, the benchmark is abandoned once the candidate is hopeless against incumbent.
+  // The first n_warmup launches are not timed.
   oclutil::Result true_core(std::function<void(std::string)> acton,
                             std::vector<double>&             times,
                             const Halt&,
-                            const AllKernArgs&);
+                            const AllKernArgs&,
+                            const Racing& racing,
+                            double        incumbent,
+                            RaceStat*     ptr_rstat,
+                            size_t        n_warmup);
+
+  // Runs the incumbent and the challenger alternately, n_each runs each in Thue-Morse order,
+  // so that both see the same drift in the device's clocks and load.
+  void interleave(const Programs&      incumbent,
+                  const AllKernArgs&   incumbent_args,
+                  const Programs&      challenger,
+                  const AllKernArgs&   challenger_args,
+                  size_t               n_each,
+                  std::vector<double>& incumbent_run_times,
+                  std::vector<double>& challenger_run_times);
+
+  // Generate and compile hp into progs, or take it from the pipeline if there is one.
+  // Returns false (and counts a compilation avoided) if hp fails the architests.
+  bool set_compiled(const HyPas&           hp,
+                    size_t                 hfi,
+                    CompilePipeline*       pipeline,
+                    Programs&              progs,
+                    std::vector<KernBlob>& v_tgks,
+                    FindTracker&           ftrack);
+
+  // Compile (or take from the pipeline) and benchmark hp. Returns the summary time [ms], or
+  // std::numeric_limits<double>::max() if hp fails the architests or to run. times are the runs
+  // (outliers removed with noise control), empty if hp was benchmarked before resuming.
+  double evaluate(const HyPas&           hp,
+                  size_t                 hfi,
+                  CompilePipeline*       pipeline,
+                  const FindParams&      fparms,
+                  double                 incumbent,
+                  FindTracker&           ftrack,
+                  std::vector<KernBlob>& v_tgks,
+                  RaceStat&              rstat,
+                  std::vector<double>&   times);
+
+  // Whether a challenger, compiled in programs with runs times summarised as t, is a new best :
+  // faster than incumbent (nullptr if there is none) by improvement_factor_required, and with
+  // noise control significantly faster, interleaved with incumbent if noise.n_interleaved > 0.
+  // Used by both single_descent_find and strategy_find. A new best becomes the incumbent.
+  bool update_incumbent(const std::vector<double>&   times,
+                        double                       t,
+                        const std::vector<KernBlob>& v_tgks,
+                        const Solution*              incumbent,
+                        SummStat::E                  sumstat);
+
+  // Find with a model-based SearchStrategy, until fparms.hl_outer halts (counting rounds).
+  Solution strategy_find(const Constraints&, const FindParams& fparms, FindTracker& ftrack);
+
+  // Successive halving over compiled candidates : runs all candidates, keeps the faster half,
+  // and repeats with twice as many runs until one remains. Returns the index of the winner.
+  size_t successive_halving(const std::vector<HyPas>&                 v_hps,
+                            const std::vector<Programs>&              v_programs,
+                            const std::vector<std::vector<KernBlob>>& v_v_tgks,
+                            const Halt&                               core_halt,
+                            const Racing&                             racing,
+                            SummStat::E                               sumstat,
+                            FindTracker&                              ftrack);
 
   AllKernArgs get_all_kern_args(const std::vector<KernBlob>& kernblobs) const;
 };
@@ -38,22 +38,56 @@ class AlphaGenerator : public basegen::BaseGenerator
   // TODO : move to derived maybe
   std::vector<Mat::E> mata_matb;
 
+  // if not 0, the kernel processes a chain of problems with this many persistent work groups
+  size_t n_chain_groups;
+
+  // with IEK, whether this is the kernel of the edge tiles (EDGE) or of the interior tiles (MAIN)
+  bool edge;
+
   virtual void set_usage() override final
   {
 
     u_a     = (hp.sus[Mat::E::A].vs[Chi::E::WOS] == Scratch::E::UNUSED) ? true : false;
     u_b     = (hp.sus[Mat::E::B].vs[Chi::E::WOS] == Scratch::E::UNUSED) ? true : false;
-    u_c     = true;
-    u_w     = (not u_a or not u_b);
+    // with partials, the splits in k write to workspace and not to c
+    u_c      = (dp.main_split_on_k_partials == 0);
+    u_w      = (not u_a or not u_b or not u_c or dp.main_stream_k != 0);
+    writes_w = (dp.main_split_on_k_partials != 0 || dp.main_stream_k != 0);
+    restrict_ab = (n_chain_groups == 0);
     u_alpha = true;
     u_beta  = dp.main_does_beta_c_inc;
   }
 
   public:
-  AlphaGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_)
-    : basegen::BaseGenerator(hp_, gg_, dp_)
+  AlphaGenerator(const HyPas&         hp_,
+                 const Geometry&      gg_,
+                 const DerivedParams& dp_,
+                 size_t               n_chain_groups_ = 0,
+                 bool                 edge_           = false)
+    : basegen::BaseGenerator(hp_, gg_, dp_), n_chain_groups(n_chain_groups_), edge(edge_)
   {
 
+    if (n_chain_groups != 0 &&
+        (dp.main_split_on_k != 0 || dp.main_stream_k != 0 ||
+         hp.sus[Mat::E::A].vs[Chi::E::WOS] != Scratch::E::UNUSED ||
+         hp.sus[Mat::E::B].vs[Chi::E::WOS] != Scratch::E::UNUSED))
+    {
+      throw miog_error("a chain of problems requires ICE = 1, GAL != STREAMK and WOS = 0 for A "
+                       "and B, so that each problem is processed by the main kernel alone");
+    }
+
+    if (edge && dp.main_interior_edge == 0)
+    {
+      throw miog_error("the edge kernel requires IEK = yes, and m or n not a multiple of the "
+                       "macro tile");
+    }
+
+    if (n_chain_groups != 0 && dp.main_interior_edge != 0)
+    {
+      throw miog_error("a chain of problems requires IEK = no, so that the main kernel "
+                       "processes all the tiles");
+    }
+
     if (hp.sus[Mat::E::C].vs[NonChi::E::AFI] == Binary::E::YES)
     {
       mata_matb = {Mat::E::A, Mat::E::B};
@@ -65,9 +99,71 @@ class AlphaGenerator : public basegen::BaseGenerator
   }
 
   private:
+  virtual size_t get_use_edge_trick() const override final
+  {
+    return (dp.main_interior_edge == 1 && !edge) ? 0 : dp.main_use_edge_trick;
+  }
+
+  virtual size_t get_n_groups(Mat::E emat_x) const override final
+  {
+    return (dp.main_interior_edge == 1 && !edge) ? dp.at(emat_x).n_interior_groups
+                                                 : dp.at(emat_x).n_groups;
+  }
+
+  size_t get_last_super_column_width() const
+  {
+    return get_n_groups(Mat::E::B) % dp.ga3_super_column_width;
+  }
+
+  // the edge kernel (IEK) : the final row of tiles if m is ragged, then the final column of tiles
+  // if n is ragged. The interior kernel uses the group allocation of GAL on the interior tiles
+  void append_edge_group_allocation_string(std::stringstream& ss)
+  {
+    bool ragged_a = dp.at(Mat::E::A).n_interior_groups != dp.at(Mat::E::A).n_groups;
+    bool ragged_b = dp.at(Mat::E::B).n_interior_groups != dp.at(Mat::E::B).n_groups;
+    if (ragged_a && ragged_b)
+    {
+      ss <<
+        R"(
+/* IEK : the edge tiles, the final row of tiles then the final column, without its final tile */
+TINTA group_id_a = N_GROUPS_A - 1;
+TINTB group_id_b = N_GROUPS_B - 1;
+if (group_id_xy < N_GROUPS_B){
+group_id_b = group_id_xy;
+}
+else{
+group_id_a = group_id_xy - N_GROUPS_B;
+}
+)";
+    }
+    else if (ragged_a)
+    {
+      ss <<
+        R"(
+/* IEK : the edge tiles, the final row of tiles */
+const TINTA group_id_a = N_GROUPS_A - 1;
+const TINTB group_id_b = group_id_xy;
+)";
+    }
+    else
+    {
+      ss <<
+        R"(
+/* IEK : the edge tiles, the final column of tiles */
+const TINTA group_id_a = group_id_xy;
+const TINTB group_id_b = N_GROUPS_B - 1;
+)";
+    }
+  }
+
   void append_group_allocation_string(std::stringstream& ss)
   {
-    if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::BYCOL)
+    if (edge)
+    {
+      append_edge_group_allocation_string(ss);
+    }
+
+    else if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::BYCOL)
     {
       ss <<
         R"(
@@ -87,6 +183,16 @@ const TINTB group_id_b = group_id_xy % N_GROUPS_B;
 )";
     }
 
+    else if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::STREAMK)
+    {
+      ss <<
+        R"(
+/* GROUP_ALLOCATION = 4 : Stream-K, the tiles are ordered column-by-column */
+const TINTA group_id_a = group_id_xy % N_GROUPS_A;
+const TINTB group_id_b = group_id_xy / N_GROUPS_A;
+)";
+    }
+
     else if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::SUCOL)
     {
       ss <<
@@ -121,7 +227,7 @@ group_id_a = (group_id_xy  - (N_GROUPS_B - LAST_SUPER_COLUMN_WIDTH)*N_GROUPS_A)
 )";
 
       // super column width perfectly fits across B
-      if (dp.ga3_last_super_column_width == 0)
+      if (get_last_super_column_width() == 0)
       {
         ss << full_SUCOL_string;
       }
@@ -130,7 +236,7 @@ group_id_a = (group_id_xy  - (N_GROUPS_B - LAST_SUPER_COLUMN_WIDTH)*N_GROUPS_A)
       {
 
         // there is just one column
-        if (dp.ga3_last_super_column_width == dp.at(Mat::E::B).n_groups)
+        if (get_last_super_column_width() == get_n_groups(Mat::E::B))
         {
           ss << partial_SUCOL_string;
         }
@@ -152,7 +258,7 @@ group_id_a = (group_id_xy  - (N_GROUPS_B - LAST_SUPER_COLUMN_WIDTH)*N_GROUPS_A)
     {
       std::stringstream err_ss;
       err_ss << "Invalid group_allocation parameter : " << hp.sus[Mat::E::C].vs[NonChi::E::GAL]
-             << ". It should be one of 1/2/3.";
+             << ". It should be one of 1/2/3/4.";
       throw miog_error(err_ss.str());
     }
   }
@@ -160,7 +266,7 @@ group_id_a = (group_id_xy  - (N_GROUPS_B - LAST_SUPER_COLUMN_WIDTH)*N_GROUPS_A)
   void append_super_column_width_defn(std::stringstream& ss)
   {
 
-    if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == 3)
+    if (hp.sus[Mat::E::C].vs[NonChi::E::GAL] == 3 && !edge)
     {
 
       ss << "\n\n"
@@ -171,13 +277,22 @@ group_id_a = (group_id_xy  - (N_GROUPS_B - LAST_SUPER_COLUMN_WIDTH)*N_GROUPS_A)
          << "#define SUPER_COLUMN_WIDTH " << dp.ga3_super_column_width;
       ss << "\n/* LAST_SUPER_COLUMN_WIDTH : N_GROUPS_B % SUPER_COLUMN_WIDTH  "
             "*/";
-      ss << "\n#define LAST_SUPER_COLUMN_WIDTH " << dp.ga3_last_super_column_width;
+      ss << "\n#define LAST_SUPER_COLUMN_WIDTH " << get_last_super_column_width();
     }
   }
 
   void append_split_on_k_vardecl_write_string(std::stringstream& ss)
   {
-    if (dp.main_split_on_k != 0)
+    if (dp.main_split_on_k_partials != 0)
+    {
+      ss << R"(
+/* each split in k writes its partial tile to its own region of workspace */
+__global TFLOAT * c = w + w_offset + GLOBAL_OFFSET_PARTIALS;
+c += ((TINTW)group_id_z)*N_ELEMENTS_PER_PARTIAL;
+)";
+    }
+
+    else if (dp.main_split_on_k != 0)
     {
       ss <<
         R"(
@@ -235,23 +350,28 @@ TFLOAT previous_value; )"
     append_loop_var_bound_incr(ss, "mu_pll_i", bound_string, increment_string, emat_x);
   }
 
-  void append_final_write_element(std::stringstream& ss,
-                                  size_t             atomic_increment,
-                                  size_t             with_beta_scaling,
-                                  size_t             with_alpha_increment)
+  // the element of rC written to (dima, dimb) of the macro tile, in the write loops
+  std::string get_rc_element()
   {
-
     std::string dima_index = hp.sus[Mat::E::A].vs[Chi::E::MIW] == 0
                                ? "dima"
                                : "(dimai*VEW_A)/N_MICRO_IN_MACRO_A + dimai_v";  //
     std::string dimb_index = hp.sus[Mat::E::B].vs[Chi::E::MIW] == 0
                                ? "dimb"
                                : "(dimbi*VEW_B)/N_MICRO_IN_MACRO_B + dimbi_v";
+    return "rC[" + dima_index + "][" + dimb_index + "]";
+  }
+
+  void append_final_write_element(std::stringstream& ss,
+                                  size_t             atomic_increment,
+                                  size_t             with_beta_scaling,
+                                  size_t             with_alpha_increment)
+  {
 
     // a good place to break kernel to check error checking.
     // make this* 1.11101242345 for example
 
-    std::string alpha_scaled = "alpha*rC[" + dima_index + "][" + dimb_index + "]";
+    std::string alpha_scaled = "alpha*" + get_rc_element();
     ss << "\nindex =  STRIDE_PLL_M_C*(write_start_a + dima) + STRIDE_PLL_N_C*(write_start_b + "
           "dimb) ;\n";
 
@@ -264,7 +384,12 @@ TFLOAT previous_value; )"
     if (with_alpha_increment != 0)
     {
       ss << '\n';
-      if (atomic_increment == 0)
+      if (dp.main_split_on_k_partials != 0)
+      {
+        ss << "c[index] = " << alpha_scaled << +";\n";
+      }
+
+      else if (atomic_increment == 0)
       {
         ss << "c[index] += " << alpha_scaled << +";\n";
       }
@@ -380,7 +505,8 @@ write_start_a + dima >= MACRO_TILE_LENGTH_A*(N_GROUPS_A - 1)
 
     else
     {
-      append_checked_wrapped_loops_from_bools(ss, with_check, 1, 0, 1);
+      append_checked_wrapped_loops_from_bools(
+        ss, with_check, 1 - dp.main_split_on_k_partials, 0, 1);
     }
   }
 
@@ -405,7 +531,7 @@ write_start_a + dima >= MACRO_TILE_LENGTH_A*(N_GROUPS_A - 1)
 
     for (auto emat : mata_matb)
     {
-      append_load_into_LDS_string(emat, ss, final_unroll, special_first_unroll);
+      append_load_into_LDS_string(emat, ss, final_unroll, special_first_unroll, "local");
     }
 
     ss <<
@@ -415,21 +541,18 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
   }
 
   // simple for loops. Could consider unrolling like Cobalt,
-  // but for the moment I use the optional pragma unroll
+  // but for the moment I use the optional pragma unroll.
+  // lds_prefix is local (localA, localB) or, for the double buffered main loop, store.
   void append_load_into_LDS_string(Mat::E             emat_x,
                                    std::stringstream& ss,
                                    size_t             final_unroll,
-                                   size_t             special_first_unroll)
+                                   size_t             special_first_unroll,
+                                   const std::string& lds_prefix)
   {
 
     char X = Mat::M().name[emat_x];
     char x = Mat::M().lcase_name[emat_x];
 
-    std::string n_jumps_string =
-      (dp.main_split_on_k == 0 || (hp.sus[Mat::E::C].vs[NonChi::E::IWI] == Binary::E::NO))
-        ? "UNROLL"
-        : "G_UNROLL";
-
     if (final_unroll != 0 && special_first_unroll != 0)
     {
       throw miog_error("From get_load_ab_into_LDS_string > It is not possible "
@@ -467,19 +590,83 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
     ss << " {\n" << dp.pragma_unroll_string;
     append_load_for_pll(emat_x, ss);
     ss << " {\n"
-       << "local" << X << "[MACRO_TILE_LENGTH_" << X << "_AND_PAD/VEW_" << X << "*(" << x
+       << lds_prefix << X << "[MACRO_TILE_LENGTH_" << X << "_AND_PAD/VEW_" << X << "*(" << x
        << "_offset_pll_unroll + mu_pll_i) + " << x << "_offset_perp_unroll_v + mu_perp_i] = \n"
        << ss_value_to_get.str() << '\n'
        << "}\n"
        << "}\n";
 
     if (final_unroll == 0)
-      ss << x << "_vec += "
-         << "(STRIDE_PLL_K_" << X << "*" << n_jumps_string << ")/VEW_" << X << ";\n";
+      append_vec_increment_string(emat_x, ss);
 
     ss << '\n';
   }
 
+  void append_vec_increment_string(Mat::E emat_x, std::stringstream& ss)
+  {
+    char X = Mat::M().name[emat_x];
+    char x = Mat::M().lcase_name[emat_x];
+
+    std::string n_jumps_string =
+      (dp.main_split_on_k == 0 || (hp.sus[Mat::E::C].vs[NonChi::E::IWI] == Binary::E::NO))
+        ? "UNROLL"
+        : "G_UNROLL";
+
+    ss << x << "_vec += "
+       << "(STRIDE_PLL_K_" << X << "*" << n_jumps_string << ")/VEW_" << X << ";\n";
+  }
+
+  // the index in the prefetch registers of the element loaded at (mu_perp_i, mu_pll_i)
+  std::string get_prefetch_index(Mat::E emat_x)
+  {
+    std::string X(1, Mat::M().name[emat_x]);
+    if (hp.sus[emat_x].vs[Chi::E::LIW] == 0)
+    {
+      return "mu_perp_i*MICRO_" + X + "_TILE_PLL_UNROLL + mu_pll_i";
+    }
+    return "(mu_perp_i/(MACRO_TILE_LENGTH_" + X + "/MICRO_" + X + "_TILE_PERP_UNROLL))*MICRO_" +
+           X + "_TILE_PLL_UNROLL + mu_pll_i/(UNROLL/MICRO_" + X + "_TILE_PLL_UNROLL)";
+  }
+
+  // PRF is YES : loading the next unroll from global memory into registers, as in
+  // append_load_into_LDS_string but with no LDS store, so it can be issued before the math
+  void append_load_into_registers_string(Mat::E emat_x, std::stringstream& ss)
+  {
+    char X = Mat::M().name[emat_x];
+    char x = Mat::M().lcase_name[emat_x];
+
+    ss << "\n/* prefetch the next unroll of " << x << " into registers */\n"
+       << dp.pragma_unroll_string;
+    append_load_for_perp(emat_x, ss);
+    ss << " {\n" << dp.pragma_unroll_string;
+    append_load_for_pll(emat_x, ss);
+    ss << " {\n"
+       << "p" << X << "[" << get_prefetch_index(emat_x) << "] = " << x
+       << "_vec[(mu_pll_i*STRIDE_PLL_K_" << X << " + VEW_" << X << "*mu_perp_i*STRIDE_PERP_K_"
+       << X << ")/VEW_" << X << "];\n"
+       << "}\n"
+       << "}\n";
+    append_vec_increment_string(emat_x, ss);
+  }
+
+  void append_store_registers_into_LDS_string(Mat::E emat_x, std::stringstream& ss)
+  {
+    char X = Mat::M().name[emat_x];
+    char x = Mat::M().lcase_name[emat_x];
+
+    ss << "\n/* store the prefetched unroll of " << x << " into LDS */\n"
+       << dp.pragma_unroll_string;
+    append_load_for_perp(emat_x, ss);
+    ss << " {\n" << dp.pragma_unroll_string;
+    append_load_for_pll(emat_x, ss);
+    ss << " {\n"
+       << "local" << X << "[MACRO_TILE_LENGTH_" << X << "_AND_PAD/VEW_" << X << "*(" << x
+       << "_offset_pll_unroll + mu_pll_i) + " << x << "_offset_perp_unroll_v + mu_perp_i] = p"
+       << X << "[" << get_prefetch_index(emat_x) << "];\n"
+       << "}\n"
+       << "}\n";
+  }
+
   std::string get_c_work_item_next(Mat::E emat_x)
   {
 
@@ -542,6 +729,125 @@ barrier(CLK_LOCAL_MEM_FENCE); )";
 barrier(CLK_LOCAL_MEM_FENCE); )";
   }
 
+  // The main loop with LDS double buffered (DBL is YES). The first unroll is loaded before the
+  // loop, after which each iteration loads the next unroll into one buffer while the math reads
+  // the other, so that the global loads are in flight during the math. One barrier per unroll
+  // suffices : it makes the next unroll visible, and ensures that the math on this unroll is
+  // complete before its buffer is loaded into, in the following iteration.
+  void append_double_buffered_main_loop(std::stringstream& ss)
+  {
+    ss << "\n\n/* LDS is double buffered : loading the first unroll into buffer 0 */\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      char X = Mat::M().name[emat_x];
+      ss << "store" << X << " = local" << X << ";\n";
+    }
+    ss << "if (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      append_load_into_LDS_string(emat_x, ss, 0, 0, "store");
+    }
+    ss << "}\n"
+       << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+       << "TSHORT lds_buffer = 0;\n"
+       << "\nwhile (n_unrolls_remaining > 0){\n"
+       << "--n_unrolls_remaining;\n"
+       << "\n/* load the next unroll into the buffer not being computed on */\n";
+
+    for (Mat::E emat_x : mata_matb)
+    {
+      char X = Mat::M().name[emat_x];
+      ss << "store" << X << " = local" << X << " + (1 - lds_buffer)*N_ELEMENTS_IN_PADDED_" << X
+         << "_UNROLL/VEW_" << X << ";\n";
+    }
+    ss << "if (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      append_load_into_LDS_string(emat_x, ss, 0, 0, "store");
+    }
+    ss << "}\n";
+
+    for (Mat::E emat_x : mata_matb)
+    {
+      char X = Mat::M().name[emat_x];
+      char x = Mat::M().lcase_name[emat_x];
+      ss << '\n'
+         << "l" << X << " = local" << X << " + lds_buffer*N_ELEMENTS_IN_PADDED_" << X
+         << "_UNROLL/VEW_" << X << " + micro_id_" << x << "*" << get_c_work_item_next(emat_x)
+         << "/VEW_" << X << ";";
+    }
+    ss << '\n';
+
+    append_math_section(ss, 0);
+    ss <<
+      R"(
+/* the next unroll is in LDS, and the math on this unroll is complete */
+barrier(CLK_LOCAL_MEM_FENCE);
+lds_buffer = 1 - lds_buffer;
+}
+)";
+  }
+
+  // The main loop with PRF YES for A and/or B. The first unroll is prefetched into registers
+  // before the loop. Each iteration stores the registers into LDS, and then, after the barrier,
+  // issues the global loads of the next unroll into the registers before the math on this one.
+  // The loads are then in flight during the math, with the LDS of DBL NO.
+  void append_register_prefetched_main_loop(std::stringstream& ss)
+  {
+    ss << "\n\n/* prefetching the first unroll into registers */\n"
+       << "if (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      if (hp.sus[emat_x].vs[Chi::E::PRF] == Binary::E::YES)
+      {
+        append_load_into_registers_string(emat_x, ss);
+      }
+    }
+    ss << "}\n"
+       << "\nwhile (n_unrolls_remaining > 0){\n"
+       << "--n_unrolls_remaining;\n";
+
+    for (Mat::E emat_x : mata_matb)
+    {
+      if (hp.sus[emat_x].vs[Chi::E::PRF] == Binary::E::YES)
+      {
+        append_store_registers_into_LDS_string(emat_x, ss);
+      }
+      else
+      {
+        append_load_into_LDS_string(emat_x, ss, 0, 0, "local");
+      }
+    }
+    ss << "\nbarrier(CLK_LOCAL_MEM_FENCE);\n"
+       << "\nif (n_unrolls_remaining > 0){\n";
+    for (Mat::E emat_x : mata_matb)
+    {
+      if (hp.sus[emat_x].vs[Chi::E::PRF] == Binary::E::YES)
+      {
+        append_load_into_registers_string(emat_x, ss);
+      }
+    }
+    ss << "}\n";
+
+    for (Mat::E emat_x : mata_matb)
+    {
+      char X = Mat::M().name[emat_x];
+      char x = Mat::M().lcase_name[emat_x];
+      ss << '\n'
+         << "l" << X << " = local" << X << " + micro_id_" << x << "*"
+         << get_c_work_item_next(emat_x) << "/VEW_" << X << ";";
+    }
+    ss << '\n';
+
+    append_math_section(ss, 0);
+    ss <<
+      R"(
+/* make sure all maths is complete, so that the registers can be stored into LDS */
+barrier(CLK_LOCAL_MEM_FENCE);
+}
+)";
+  }
+
   void append_final_unroll_string(std::stringstream& ss)
   {
 
@@ -626,10 +932,21 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     char X = Mat::M().name[emat_x];
 
     ss << '\n' << dp.pragma_unroll_string;
-    ss << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_" << X << "/VEW_" << X << "; ++i){\n";
 
-    if (hp.sus[emat_x].vs[Chi::E::VEW] != 1)
+    if (dp.at(emat_x).main_lds_read_width != hp.sus[emat_x].vs[Chi::E::VEW])
+    {
+      // LRW > VEW : MIW is 0, so the micro tile is contiguous (and aligned) in LDS
+      ss << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_" << X << "/LRW_" << X << "; ++i){\n";
+      for (unsigned j = 0; j < dp.at(emat_x).main_lds_read_width; ++j)
+      {
+        ss << "r" << X << "[LRW_" << X << "*i + " << j << "] = ((__local const TLFLOAT" << X
+           << " *)l" << X << ")[i].s" << j << ";\n";
+      }
+    }
+
+    else if (hp.sus[emat_x].vs[Chi::E::VEW] != 1)
     {
+      ss << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_" << X << "/VEW_" << X << "; ++i){\n";
       for (unsigned j = 0; j < hp.sus[emat_x].vs[Chi::E::VEW]; ++j)
       {
         ss << "r" << X << "[VEW_" << X << "*i + " << j << "] = l" << X << "["
@@ -639,6 +956,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
     }
     else
     {
+      ss << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_" << X << "/VEW_" << X << "; ++i){\n";
       ss << "r" << X << "[i] = l" << X << "[i*C_INTERWEAVE_STRIDE_" << X << "];\n";
     }
     ss << "}\n";
@@ -663,7 +981,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
   void append_final_write_all(std::stringstream& ss)
   {
 
-    if (dp.main_use_edge_trick == 0)
+    if (get_use_edge_trick() == 0)
     {
       ss << '\n';
       append_final_write_loops_no_check(ss);
@@ -696,7 +1014,7 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
       else
       {
 
-        if (dp.main_use_edge_trick == 0)
+        if (get_use_edge_trick() == 0)
         {
           throw miog_error("in alphagenerator, dp.main_use_edge_trick == 0. "
                            "however, non-perfectly tilable");
@@ -741,11 +1059,159 @@ if ((group_id_z == N_WORK_ITEMS_PER_C_ELM - 1) && k_remaining > 0){
          << hp.sus[Mat::E::C].vs[NonChi::E::ICE] * hp.sus[Mat::E::C].vs[NonChi::E::UNR]
          << " // N_WORK_ITEMS_PER_C_ELM*UNROLL";
     }
+
+    if (dp.main_stream_k != 0)
+    {
+      ss << "\n/* Stream-K : the (tile, unroll) iterations, shared by the persistent groups */\n"
+         << "#define N_PERSISTENT_GROUPS " << dp.main_n_work_groups << '\n'
+         << "#define ITERATIONS_PER_TILE " << dp.main_sk_iterations_per_tile << '\n'
+         << "#define N_SK_ITERATIONS " << dp.main_sk_n_iterations << "UL\n";
+    }
+
+    if (dp.main_split_on_k_partials != 0 || dp.main_stream_k != 0)
+    {
+      ss << "\n/* the partial tiles (" << (dp.main_stream_k != 0 ? "Stream-K" : "DSK")
+         << "), summed by the reduce kernel */\n"
+         << "#define GLOBAL_OFFSET_PARTIALS " << dp.reduce_global_offset << '\n'
+         << "#define N_ELEMENTS_PER_PARTIAL " << dp.reduce_n_elements_per_partial << '\n';
+    }
+  }
+
+  // Stream-K : each persistent work group processes a contiguous range of the (tile, unroll)
+  // iterations, tile by tile. The LDS is declared outside of the loop over tiles, as required
+  // for __local, and a and b are reset at the start of each tile.
+  void append_stream_k_loop_open(std::stringstream& ss)
+  {
+    ss << R"(
+/* Stream-K : the range of (tile, unroll) iterations of this work group */
+const TINTC group_id = get_group_id(0);
+const ulong sk_first = (group_id*N_SK_ITERATIONS)/N_PERSISTENT_GROUPS;
+const ulong sk_last = ((group_id + 1)*N_SK_ITERATIONS)/N_PERSISTENT_GROUPS;
+)";
+    for (auto emat_x : mata_matb)
+    {
+      append_lds_declaration(ss, emat_x);
+    }
+    for (auto emat_x : mata_matb)
+    {
+      if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::UNUSED)
+      {
+        char x = Mat::M().lcase_name[emat_x];
+        ss << "__global const TFLOAT * const " << x << "_base = " << x << ";\n";
+      }
+    }
+
+    ss << R"(
+ulong sk_iteration = sk_first;
+while (sk_iteration < sk_last){
+
+/* the tile of this iteration, and its unrolls which this work group processes */
+const TINTC group_id_xy = sk_iteration / ITERATIONS_PER_TILE;
+const TINTK sk_unroll_begin = sk_iteration - group_id_xy*ITERATIONS_PER_TILE;
+const TINTK sk_unroll_end = 
+min(sk_last - group_id_xy*ITERATIONS_PER_TILE, (ulong)ITERATIONS_PER_TILE);
+)";
+    for (auto emat_x : mata_matb)
+    {
+      if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::UNUSED)
+      {
+        char x = Mat::M().lcase_name[emat_x];
+        ss << "__global const TFLOAT * restrict " << x << " = " << x << "_base;\n";
+      }
+    }
+  }
+
+  // A chain of problems : the persistent work groups process the problems in order, and the
+  // tiles of a problem round-robin. A problem starts when all work groups have signalled, in
+  // chain_state, that they have completed the previous one, so that its c can be read as a or b.
+  // The signal is a device scope release and the wait a device scope acquire (OpenCL 2.0), and
+  // a and b are not restrict, so the c of the previous problem is visible to the loads. The wait
+  // makes progress only if all the persistent work groups are resident : there are at most as
+  // many as compute units, one work group per compute unit (see ProgramCacher::get_ID).
+  void append_chain_loops_open(std::stringstream& ss)
+  {
+    ss << "\n#define N_TILES " << dp.main_n_work_groups << '\n';
+    for (auto emat_x : mata_matb)
+    {
+      append_lds_declaration(ss, emat_x);
+    }
+    for (auto emat_x : mata_matb)
+    {
+      char x = Mat::M().lcase_name[emat_x];
+      ss << "__global const TFLOAT * const " << x << "_base = " << x << ";\n";
+    }
+    ss << R"(__global TFLOAT * const c_base = c;
+
+for (uint chain_i = 0; chain_i < n_chain; ++chain_i){
+
+/* wait for all work groups to complete the previous problem */
+if (chain_i > 0){
+if (get_local_id(0) == 0){
+while (atomic_load_explicit(chain_state + chain_i - 1, memory_order_acquire,
+memory_scope_device) < (int)get_num_groups(0)){}
+}
+work_group_barrier(CLK_LOCAL_MEM_FENCE | CLK_GLOBAL_MEM_FENCE, memory_scope_device);
+}
+
+for (uint tile_i = get_group_id(0); tile_i < N_TILES; tile_i += get_num_groups(0)){
+const TINTC group_id_xy = tile_i;
+)";
+    for (auto emat_x : mata_matb)
+    {
+      char x = Mat::M().lcase_name[emat_x];
+      ss << "__global const TFLOAT * " << x << " = " << x << "_base + chain_table[3*chain_i + "
+         << (emat_x == Mat::E::A ? 0 : 1) << "];\n";
+    }
+    ss << "__global TFLOAT * c = c_base + chain_table[3*chain_i + 2];\n";
+  }
+
+  void append_chain_loops_close(std::stringstream& ss)
+  {
+    ss << R"(
+}
+
+/* signal that this work group has completed problem chain_i */
+work_group_barrier(CLK_GLOBAL_MEM_FENCE, memory_scope_device);
+if (get_local_id(0) == 0){
+atomic_fetch_add_explicit(chain_state + chain_i, 1, memory_order_release, memory_scope_device);
+}
+}
+)";
+  }
+
+  // a tile processed entirely by this work group is written to c, otherwise the partial tile
+  // is written to its slot in workspace : the first slot of this work group if it is the tile
+  // it starts in, else the second. The reduce kernel adds the partial tiles to c.
+  void append_stream_k_write_and_loop_close(std::stringstream& ss)
+  {
+    ss << "\nif (sk_unroll_begin == 0 && sk_unroll_end == ITERATIONS_PER_TILE){\n";
+    append_final_write_all(ss);
+    ss << R"(
+}
+
+else{
+__global TFLOAT * sk_partial = w + w_offset + GLOBAL_OFFSET_PARTIALS;
+sk_partial += ((TINTW)(2*group_id + (sk_iteration != sk_first)))*N_ELEMENTS_PER_PARTIAL;
+)";
+    append_for_loops_for_c_write_open(ss);
+    ss << "sk_partial[(write_start_a + dima - write_macro_tile_start_a) + "
+          "MACRO_TILE_LENGTH_A*(write_start_b + dimb - write_macro_tile_start_b)] = "
+       << get_rc_element() << ";";
+    append_for_loops_for_c_write_close(ss);
+    ss << R"(}
+
+sk_iteration = group_id_xy*ITERATIONS_PER_TILE + sk_unroll_end;
+}
+)";
   }
 
   void append_group_id_defns(std::stringstream& ss)
   {
-    if (dp.main_split_on_k == 0)
+    if (dp.main_stream_k != 0 || n_chain_groups != 0)
+    {
+      // defined at the start of the loop over tiles
+    }
+    else if (dp.main_split_on_k == 0)
     {
       ss << "\nconst TINTC group_id_xy = get_group_id(0);\n";
     }
@@ -760,20 +1226,18 @@ const TSHORT group_id_z = group_id % N_WORK_ITEMS_PER_C_ELM;
     }
   }
 
-  void append_stride_c_defn(std::stringstream& ss)
-  {
-
-    size_t transposed_xor_is_col_major = (gg.tX[Mat::E::C] + gg.isColMajor) % 2;
-    ss << "#define STRIDE_PLL_M_C " << (transposed_xor_is_col_major == 1 ? 1 : gg.ldX[Mat::E::C])
-       << '\n';
-    ss << "#define STRIDE_PLL_N_C " << (transposed_xor_is_col_major == 0 ? 1 : gg.ldX[Mat::E::C])
-       << '\n';
-  }
-
   void append_n_unrolls_remaining_string(std::stringstream& ss)
   {
 
-    if (dp.main_split_on_k == 0)
+    if (dp.main_stream_k != 0)
+    {
+      ss << "\n/* Stream-K : the unrolls of this tile processed by this work group, "
+            "excluding the tail */";
+      ss << "\nint n_unrolls_remaining = (sk_unroll_end < " << dp.k_effective_div_UNROLL
+         << " ? sk_unroll_end : " << dp.k_effective_div_UNROLL << ") - sk_unroll_begin;";
+    }
+
+    else if (dp.main_split_on_k == 0)
     {
       ss << "\nint n_unrolls_remaining = " << dp.k_effective_div_UNROLL << ";";
     }
@@ -848,6 +1312,24 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     }
   }
 
+  void append_lds_declaration(std::stringstream& ss, Mat::E emat_x)
+  {
+    char X = Mat::M().name[emat_x];
+    if (emat_x == Mat::E::A)
+      ss << "/* LDS memory */\n";
+    ss << "__local "
+       << "TVFLOAT" << X << " local" << X << "[" << (dp.main_n_lds_buffers == 2 ? "2*" : "")
+       << "N_ELEMENTS_IN_PADDED_" << X << "_UNROLL"
+       << "/VEW_" << X << "]";
+    if (dp.at(emat_x).main_lds_read_width != hp.sus[emat_x].vs[Chi::E::VEW])
+    {
+      // aligned for reads of TLFLOAT
+      ss << " __attribute__((aligned("
+         << dp.at(emat_x).main_lds_read_width * gg.derived.float_size_bytes << ")))";
+    }
+    ss << ";\n";
+  }
+
   void append_id_string_sym(std::stringstream& ss, Mat::E emat_x)
   {
 
@@ -856,11 +1338,16 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     ss << '\n';
 
-    if (emat_x == Mat::E::A)
-      ss << "/* LDS memory */\n";
-    ss << "__local "
-       << "TVFLOAT" << X << " local" << X << "[N_ELEMENTS_IN_PADDED_" << X << "_UNROLL"
-       << "/VEW_" << X << "];\n";
+    if (dp.main_stream_k == 0 && n_chain_groups == 0)
+    {
+      append_lds_declaration(ss, emat_x);
+    }
+    if (dp.main_n_lds_buffers == 2)
+    {
+      if (emat_x == Mat::E::A)
+        ss << "/* the LDS buffer being loaded into, with double buffering */\n";
+      ss << "__local TVFLOAT" << X << " * store" << X << ";\n";
+    }
     if (emat_x == Mat::E::A)
       ss << "/* jumping pointer to locate the LDS to load into register memory "
             "*/\n";
@@ -868,13 +1355,19 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     if (emat_x == Mat::E::A)
       ss << "/* register memory */ \n";
     ss << "TFLOAT r" << X << "[MICRO_TILE_LENGTH_" << X << "];\n";
+    if (hp.sus[emat_x].vs[Chi::E::PRF] == Binary::E::YES)
+    {
+      ss << "/* registers for the prefetched unroll of " << x << " */\n";
+      ss << "TVFLOAT" << X << " p" << X << "[N_ELEMENTS_OF_" << X << "_TO_LOAD_PER_WORKITEM/VEW_"
+         << X << "];\n";
+    }
     if (emat_x == Mat::E::A)
       ss << "/* Define which part of the C macro-tile this thread will process "
             "(% / or / % ? "
             "doesn't seem to make much difference) */\n";
     ss << "TINT" << X << " write_macro_tile_start_" << x << " = group_id_" << x
        << "*MACRO_TILE_LENGTH_" << X << "; \n";
-    if (dp.main_use_edge_trick != 0)
+    if (get_use_edge_trick() != 0)
     {
       if (emat_x == Mat::E::A)
         ss << "/* tile on edge : pulling it in so no C overflow */\n";
@@ -916,7 +1409,7 @@ TINTK k_plus_offset = KV__ + unroll_offset;
             "seem to make much difference) */\n";
     ss << "TINT" << X << " read_macro_tile_start_" << x << " = group_id_" << x
        << "*MACRO_TILE_LENGTH_" << X << "; \n";
-    if (dp.main_use_edge_trick != 0 && hp.sus[emat_x].vs[Chi::E::WOS] != Scratch::E::NFORM)
+    if (get_use_edge_trick() != 0 && hp.sus[emat_x].vs[Chi::E::WOS] != Scratch::E::NFORM)
     {
       if (emat_x == Mat::E::A)
         ss << "/* tile on edge and A is not normal form: pulling in read zone "
@@ -970,6 +1463,13 @@ TINTK k_plus_offset = KV__ + unroll_offset;
       }
     }
 
+    if (dp.main_stream_k != 0)
+    {
+      if (emat_x == Mat::E::A)
+        ss << "/* Stream-K : move to the first unroll of the tile processed by this group */\n";
+      ss << x << " += sk_unroll_begin*UNROLL*STRIDE_PLL_K_" << X << ";\n";
+    }
+
     if (hp.sus[Mat::E::C].vs[NonChi::E::UFO] != 0)
     {
       if (emat_x == Mat::E::A)
@@ -1059,6 +1559,14 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     ss << "#define VEW_" << x << "  " << hp.sus[emat_x].vs[Chi::E::VEW];
     ss << '\n';
 
+    if (dp.at(emat_x).main_lds_read_width != hp.sus[emat_x].vs[Chi::E::VEW])
+    {
+      ss << "/* reading from LDS into registers : width and vector float type */\n";
+      ss << "#define LRW_" << x << "  " << dp.at(emat_x).main_lds_read_width << '\n';
+      ss << "#define TLFLOAT" << x << " " << dp.t_float << dp.at(emat_x).main_lds_read_width
+         << '\n';
+    }
+
     if (emat_x == Mat::E::A)
       ss << "/* micro tiles define the pattern of C that individual threads "
             "process */\n";
@@ -1115,6 +1623,10 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     ss << "#define C_INTERWEAVE_STRIDE_" << x << " " << dp.at(emat_x).main_c_interweave_stride
        << '\n';
 
+    if (emat_x == Mat::E::A)
+      ss << "/* whether the next unroll is prefetched into registers during the math */\n";
+    ss << "#define PREFETCH_TO_REGISTERS_" << x << " " << hp.sus[emat_x].vs[Chi::E::PRF] << '\n';
+
     if (hp.sus[emat_x].vs[Chi::E::WOS] != Scratch::E::UNUSED)
     {
       if (emat_x == Mat::E::A)
@@ -1188,7 +1700,7 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     ss << "/* this precompiler defn has no direct influence on the running the "
           "kernel, "
           "implementation already done in make_kernel.py */\n";
-    ss << "#define EDGETRICK " << dp.main_use_edge_trick << '\n';
+    ss << "#define EDGETRICK " << get_use_edge_trick() << '\n';
     ss << "/* the number of work items working on the same c element. if this "
           "is 1, there will be "
           "just one thread doing all k multiply-adds, */\n";
@@ -1201,7 +1713,8 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     ss << R"(/* define the way in which work groups are assigned to tiles */
 /* 1 : column-by-column
  * 2 : row-by-row 
- * 3 : by rows within super-column  */
+ * 3 : by rows within super-column 
+ * 4 : Stream-K, persistent work groups share the (tile, unroll) iterations */
 )";
 
     append_group_allocation_defn_string(ss);
@@ -1227,6 +1740,8 @@ TINTK k_plus_offset = KV__ + unroll_offset;
           "(26/08/2016, Catalyst) it "
           "seems that leaving this as 0 is best.  */\n";
     ss << "#define N_PREFETCH_FOR_LDS_LOAD " << 0 << '\n';
+    ss << "/* whether LDS is double buffered : the next unroll is loaded during this math */\n";
+    ss << "#define DOUBLE_BUFFER_LDS " << hp.sus[Mat::E::C].vs[NonChi::E::DBL] << '\n';
     ss << "#define MACRO_TILE_AREA " << dp.main_macro_tile_area << '\n';
     ss << "#define MICRO_TILE_AREA " << dp.main_micro_tile_area << '\n';
     ss << "#define N_WORK_ITEMS_PER_WORKGROUP  " << dp.main_n_work_items_per_workgroup << '\n';
@@ -1238,11 +1753,11 @@ TINTK k_plus_offset = KV__ + unroll_offset;
     ss << "/* N_WORK_ITEMS_PER_C_ELM * ((M/MACRO_TILE_LENGTH_A) + "
           "(M%MACRO_TILE_LENGTH_A != 0)) * "
           "((N/MACRO_TILE_LENGTH_B) + (N%MACRO_TILE_LENGTH_B != 0)) */ \n";
-    ss << "#define N_WORK_GROUPS " << dp.main_n_work_groups << '\n';
+    ss << "#define N_WORK_GROUPS " << get_n_work_groups() << '\n';
     ss << "/* the global work size, ie the total mumber of work items "
           "(threads) which will run */\n ";
     ss << "/* N_WORK_GROUPS * N_WORK_ITEMS_PER_WORKGROUP */ \n";
-    ss << "#define GLOBAL_WORK_SIZE " << dp.main_global_work_size << '\n';
+    ss << "#define GLOBAL_WORK_SIZE " << get_global_work_size() << '\n';
 
     append_stride_c_defn(ss);
     append_split_on_k_defns_string(ss);
@@ -1256,7 +1771,20 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     ss << "\n{\n\n";
 
-    append_c_offset_string(ss);
+    if (u_c)
+    {
+      append_c_offset_string(ss);
+    }
+
+    if (dp.main_stream_k != 0)
+    {
+      append_stream_k_loop_open(ss);
+    }
+
+    else if (n_chain_groups != 0)
+    {
+      append_chain_loops_open(ss);
+    }
 
     append_id_string_nonsym(ss);
 
@@ -1276,23 +1804,56 @@ TINTK k_plus_offset = KV__ + unroll_offset;
 
     append_first_unroll_block(ss);
 
-    ss << "\n\nwhile (n_unrolls_remaining > 0){\n";
-    append_relocate_load_math_string(ss, 0, 0);
-    ss << "\n--n_unrolls_remaining;\n}\n";
+    if (dp.main_n_lds_buffers == 2)
+    {
+      append_double_buffered_main_loop(ss);
+    }
+    else if (hp.sus[Mat::E::A].vs[Chi::E::PRF] == Binary::E::YES ||
+             hp.sus[Mat::E::B].vs[Chi::E::PRF] == Binary::E::YES)
+    {
+      append_register_prefetched_main_loop(ss);
+    }
+    else
+    {
+      ss << "\n\nwhile (n_unrolls_remaining > 0){\n";
+      append_relocate_load_math_string(ss, 0, 0);
+      ss << "\n--n_unrolls_remaining;\n}\n";
+    }
 
     if (dp.main_final_fractional_unroll == 1)
     {
       ss << "\n/* *********** processing the tail *************** */\n";
+      if (dp.main_stream_k != 0)
+      {
+        ss << "\n/* Stream-K : the tail is the last iteration of the tile */\n"
+           << "if (sk_unroll_end == ITERATIONS_PER_TILE){\n";
+      }
       append_k_remaining_string(ss);
       append_final_unroll_string(ss);
+      if (dp.main_stream_k != 0)
+      {
+        ss << "\n}\n";
+      }
       ss << "\n/* *********************************************** */\n\n";
     }
 
     ss << "\n\n";
     ss << "TINTC index;\n";
 
-    append_split_on_k_vardecl_write_string(ss);
-    append_final_write_all(ss);
+    if (dp.main_stream_k != 0)
+    {
+      append_stream_k_write_and_loop_close(ss);
+    }
+    else
+    {
+      append_split_on_k_vardecl_write_string(ss);
+      append_final_write_all(ss);
+    }
+
+    if (n_chain_groups != 0)
+    {
+      append_chain_loops_close(ss);
+    }
 
     ss << "\n}\n";
 
@@ -1300,22 +1861,47 @@ TINTK k_plus_offset = KV__ + unroll_offset;
             {u_a, u_b, u_c, u_w, u_alpha, u_beta},
             ss.str(),
             kernelname,
-            dp.main_global_work_size,
+            n_chain_groups != 0 ? n_chain_groups * dp.main_n_work_items_per_workgroup
+                                : get_global_work_size(),
             dp.main_n_work_items_per_workgroup};
   }
 
   virtual size_t get_local_work_size() override final { return dp.main_n_work_items_per_workgroup; }
 
-  virtual size_t get_n_work_groups() override final { return dp.main_n_work_groups; }
+  virtual size_t get_n_work_groups() override final
+  {
+    return edge ? dp.edge_n_work_groups : dp.main_n_work_groups;
+  }
+
+  size_t get_global_work_size() { return get_n_work_groups() * dp.main_n_work_items_per_workgroup; }
 
   virtual void set_type() override final
   {
     type = dp.main_does_beta_c_inc ? "betac_alphaab" : "alphaab";
+    if (n_chain_groups != 0)
+    {
+      type += "_chain";
+    }
+    if (edge)
+    {
+      type += "_edge";
+    }
+  }
+
+  virtual void append_additional_fargs(std::stringstream& ss) override final
+  {
+    if (n_chain_groups != 0)
+    {
+      append_farg(true,
+                  ss,
+                  "\n__global const ulong * restrict chain_table, \nconst uint n_chain, "
+                  "\n__global atomic_int * chain_state");
+    }
   }
 
   virtual void setup_final() override final {}
 
-  virtual KType::E get_ktype() override final { return KType::E::MAIN; }
+  virtual KType::E get_ktype() override final { return edge ? KType::E::EDGE : KType::E::MAIN; }
 };
 
 KernBlob get_alpha_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
@@ -1324,5 +1910,27 @@ KernBlob get_alpha_kernelstring(const HyPas& hp, const Geometry& gg, const Deriv
   ag.setup();
   return ag.get_kernelstring();
 }
+
+KernBlob get_alpha_chain_kernelstring(const HyPas&         hp,
+                                      const Geometry&      gg,
+                                      const DerivedParams& dp,
+                                      size_t               n_persistent_groups)
+{
+  if (n_persistent_groups == 0)
+  {
+    throw miog_error("n_persistent_groups should be strictly positive, in "
+                     "get_alpha_chain_kernelstring");
+  }
+  AlphaGenerator ag(hp, gg, dp, n_persistent_groups);
+  ag.setup();
+  return ag.get_kernelstring();
+}
+
+KernBlob get_alpha_edge_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+{
+  AlphaGenerator ag(hp, gg, dp, 0, true);
+  ag.setup();
+  return ag.get_kernelstring();
+}
 }
 }
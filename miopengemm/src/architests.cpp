@@ -1,6 +1,7 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
+#include <algorithm>
 #include <sstream>
 #include <miopengemm/architests.hpp>
 #include <miopengemm/oclutil.hpp>
@@ -10,13 +11,103 @@ namespace MIOpenGEMM
 namespace architests
 {
 
+namespace gcn
+{
+const size_t simds_per_cu       = 4;
+const size_t max_waves_per_simd = 10;
+const size_t max_workgroups     = 16;
+const size_t vgprs_per_lane     = 256;
+const size_t vgpr_granularity   = 4;
+const size_t sgprs_per_simd     = 800;
+const size_t sgpr_granularity   = 16;
+const size_t transaction_bytes  = 64;
+const size_t overhead_vgprs     = 12;
+const size_t overhead_sgprs     = 32;
+}
+
+namespace
+{
+size_t round_up(size_t x, size_t granularity)
+{
+  return granularity * ((x + granularity - 1) / granularity);
+}
+}
+
+Resources::Resources(const oclutil::DevInfo& devinfo,
+                     const DerivedParams&    dp,
+                     const Geometry&         gg,
+                     const HyPas&            hp)
+{
+  size_t words = std::max<size_t>(1, gg.derived.float_size_bytes / 4);
+
+  // accumulators, the A and B fragments of an unroll step, and indices. Without PRF, loads from
+  // global memory are stored straight to LDS, with PRF they are held in registers over an unroll
+  size_t staged = 0;
+  for (auto emat : {Mat::E::A, Mat::E::B})
+  {
+    if (hp.sus[emat].vs[Chi::E::PRF] == Binary::E::YES)
+    {
+      staged += dp.at(emat).main_n_elements_to_load_per_workitem;
+    }
+  }
+  vgprs = gcn::overhead_vgprs +
+          words * (dp.main_micro_tile_area + hp.sus[Mat::E::A].vs[Chi::E::MIC] +
+                   hp.sus[Mat::E::B].vs[Chi::E::MIC] + staged);
+  vgprs = round_up(vgprs, gcn::vgpr_granularity);
+
+  // kernel arguments and uniform indices. Coarse, SGPRs rarely limit occupancy
+  sgprs = round_up(gcn::overhead_sgprs + (gg.wSpaceSize > 0 ? 4 : 0), gcn::sgpr_granularity);
+
+  lds_bytes = dp.main_n_lds_buffers * gg.derived.float_size_bytes *
+              (dp.at(Mat::E::A).main_n_elements_in_padded_unroll +
+               dp.at(Mat::E::B).main_n_elements_in_padded_unroll);
+
+  size_t wave_size    = std::max<size_t>(1, devinfo.wg_atom_size);
+  waves_per_workgroup = (dp.main_n_work_items_per_workgroup + wave_size - 1) / wave_size;
+
+  size_t waves_vgpr = vgprs > gcn::vgprs_per_lane ? 0 : gcn::vgprs_per_lane / vgprs;
+  size_t waves_sgpr = gcn::sgprs_per_simd / sgprs;
+  size_t waves_per_simd = std::min({gcn::max_waves_per_simd, waves_vgpr, waves_sgpr});
+
+  workgroups_per_cu = std::min(gcn::max_workgroups,
+                               gcn::simds_per_cu * waves_per_simd / waves_per_workgroup);
+  if (devinfo.device_local_mem_size > 0 && lds_bytes > 0)
+  {
+    workgroups_per_cu = std::min(workgroups_per_cu, devinfo.device_local_mem_size / lds_bytes);
+  }
+
+  occupancy = static_cast<double>(workgroups_per_cu * waves_per_workgroup) /
+              (gcn::simds_per_cu * gcn::max_waves_per_simd);
+
+  // a work group reads contiguous runs of the macro tile (or unroll) length per line
+  double used  = 0;
+  double moved = 0;
+  for (auto emat : {Mat::E::A, Mat::E::B})
+  {
+    size_t run_length = gg.coal_is_pll_k(emat) ? hp.sus[Mat::E::C].vs[NonChi::E::UNR]
+                                               : dp.at(emat).macro_tile_length;
+    size_t run_bytes  = run_length * gg.derived.float_size_bytes;
+    double weight     = static_cast<double>(dp.at(emat).macro_tile_length);
+    used += weight * run_bytes;
+    moved += weight * round_up(run_bytes, gcn::transaction_bytes);
+  }
+  load_efficiency = used / moved;
+}
+
+std::string Resources::get_string() const
+{
+  std::stringstream ss;
+  ss << "VGPRs " << vgprs << "  SGPRs " << sgprs << "  LDS " << lds_bytes << "  WGs/CU "
+     << workgroups_per_cu << "  occupancy " << occupancy << "  load efficiency "
+     << load_efficiency;
+  return ss.str();
+}
+
 Stat::Stat(const oclutil::DevInfo& devinfo,
            const DerivedParams&    dp,
            const Geometry&         gg,
            const HyPas&            hp)
 {
-  (void)hp;
-
   std::stringstream status_ss;
 
   // check -1 : macro tile not too large
@@ -27,11 +118,10 @@ Stat::Stat(const oclutil::DevInfo& devinfo,
               << " ) : cannot compile this kernel to this architecture \n";
   }
 
-  // check 0 : LDS
-  size_t LDS_required =
-    gg.derived.float_size_bytes * ((dp.at(Mat::E::A).main_n_elements_in_padded_unroll +
-                                    dp.at(Mat::E::B).main_n_elements_in_padded_unroll));
+  Resources resources(devinfo, dp, gg, hp);
 
+  // check 0 : LDS
+  size_t LDS_required = resources.lds_bytes;
   if (LDS_required >= devinfo.device_local_mem_size)  // max_LDS_bytes)
   {
     status_ss << "LDS_required (" << LDS_required << ")  >= max_LDS_bytes ("
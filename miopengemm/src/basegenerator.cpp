@@ -31,19 +31,30 @@ void BaseGenerator::append_farg(bool u_x, std::stringstream& ss, const std::stri
 void BaseGenerator::append_fargs(std::stringstream& ss)
 {
   ss << "\n(";
-  append_farg(u_a, ss, "\n__global const TFLOAT * restrict a, \nconst ulong a_offset");
-  append_farg(u_b, ss, "\n__global const TFLOAT * restrict b, \nconst ulong b_offset");
+  std::string ab_restrict = restrict_ab ? "restrict " : "";
+  append_farg(u_a, ss, "\n__global const TFLOAT * " + ab_restrict + "a, \nconst ulong a_offset");
+  append_farg(u_b, ss, "\n__global const TFLOAT * " + ab_restrict + "b, \nconst ulong b_offset");
   append_farg(u_c, ss, "\n__global TFLOAT       *          c, \nconst ulong c_offset");
-  // if using c, we assume workspace is const.
-  // this is a hacky, as we might have a kernel
-  // which uses c and modifies w as well.
-  std::string cness = (u_c == true) ? "const " : "";
+  // if using c, we assume workspace is const,
+  // unless the kernel says it modifies w as well.
+  std::string cness = (u_c == true && writes_w == false) ? "const " : "";
   append_farg(u_w, ss, "\n__global " + cness + "TFLOAT * restrict w,\nconst ulong w_offset");
   append_farg(u_alpha, ss, "\nconst TFLOAT alpha");
   append_farg(u_beta, ss, "\nconst TFLOAT beta");
+  append_additional_fargs(ss);
   ss << ")\n";
 }
 
+void BaseGenerator::append_stride_c_defn(std::stringstream& ss)
+{
+
+  size_t transposed_xor_is_col_major = (gg.tX[Mat::E::C] + gg.isColMajor) % 2;
+  ss << "#define STRIDE_PLL_M_C " << (transposed_xor_is_col_major == 1 ? 1 : gg.ldX[Mat::E::C])
+     << '\n';
+  ss << "#define STRIDE_PLL_N_C " << (transposed_xor_is_col_major == 0 ? 1 : gg.ldX[Mat::E::C])
+     << '\n';
+}
+
 void BaseGenerator::append_stride_definitions(Mat::E             emat_x,
                                               std::stringstream& ss,
                                               size_t             workspace_type,
@@ -100,15 +111,15 @@ void BaseGenerator::append_unroll_block_geometry(Mat::E             emat_x,
     ss << "/* number of groups covering " << (X == 'A' ? 'M' : 'N') << " / MACRO_TILE_LENGTH"
        << X_string;
 
-    if (dp.main_use_edge_trick == 1)
+    if (get_use_edge_trick() == 1)
     {
       ss << " + (PRESHIFT_FINAL_TILE" << X_string << " != MACRO_TILE_LENGTH" << X_string << ")";
     }
     ss << " */\n";
   }
-  ss << "#define N_GROUPS" << X_string << ' ' << dp.at(emat_x).n_groups << '\n';
+  ss << "#define N_GROUPS" << X_string << ' ' << get_n_groups(emat_x) << '\n';
 
-  if (dp.main_use_edge_trick != 0)
+  if (get_use_edge_trick() != 0)
   {
     if (withcomments == true)
     {
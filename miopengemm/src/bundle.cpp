@@ -18,7 +18,11 @@
 #include <miopengemm/copygenerator.hpp>
 #include <miopengemm/derivedparams.hpp>
 #include <miopengemm/error.hpp>
+#include <miopengemm/fusedprepgenerator.hpp>
 #include <miopengemm/normalformgenerator.hpp>
+#include <miopengemm/reducegenerator.hpp>
+#include <miopengemm/skinnygenerator.hpp>
+#include <miopengemm/streamkgenerator.hpp>
 #include <miopengemm/stringutilbase.hpp>
 
 namespace MIOpenGEMM
@@ -111,12 +115,18 @@ std::vector<std::vector<size_t>> get_v_wait_indices(const std::vector<KernBlob>&
 Bundle::Bundle(const HyPas& hp_, const Geometry& gg_) : hp(hp_), gg(gg_), dp(hp, gg)
 {
 
+  // with workspace for both A and B, one kernel prepares both
+  if (dp.prep_fused == 1)
+  {
+    v_tgks.emplace_back(fusedprepgen::get_fused_prep_kernelstring(hp, gg, dp));
+  }
+
   for (auto emat_x : {Mat::E::A, Mat::E::B})
   {
 
-    if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::UNUSED)
+    if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::UNUSED || dp.prep_fused == 1)
     {
-      // no workspace kernel
+      // no workspace kernel, or prepared by the fused kernel
     }
 
     else if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::COPY)
@@ -138,12 +148,39 @@ Bundle::Bundle(const HyPas& hp_, const Geometry& gg_) : hp(hp_), gg(gg_), dp(hp,
     }
   }
 
-  if (dp.main_does_beta_c_inc == 0)
+  // with partials, the beta scaling is done in the reduce kernel
+  if (dp.main_does_beta_c_inc == 0 && dp.main_split_on_k_partials == 0)
   {
     v_tgks.emplace_back(betacgen::get_betac_kernelstring(hp, gg, dp));
   }
 
-  v_tgks.emplace_back(alphagen::get_alpha_kernelstring(hp, gg, dp));
+  // for small n, the skinny kernel replaces the (LDS tiled) alpha kernel
+  if (dp.main_skinny == 1)
+  {
+    v_tgks.emplace_back(skinnygen::get_skinny_kernelstring(hp, gg, dp));
+  }
+
+  else
+  {
+    v_tgks.emplace_back(alphagen::get_alpha_kernelstring(hp, gg, dp));
+  }
+
+  // with IEK, the tiles on the ragged edges are processed after the interior tiles
+  if (dp.main_interior_edge == 1)
+  {
+    v_tgks.emplace_back(alphagen::get_alpha_edge_kernelstring(hp, gg, dp));
+  }
+
+  if (dp.main_split_on_k_partials == 1)
+  {
+    v_tgks.emplace_back(reducegen::get_reduce_kernelstring(hp, gg, dp));
+  }
+
+  // with Stream-K, the tiles shared by persistent work groups are completed in the fix-up
+  else if (dp.main_stream_k == 1)
+  {
+    v_tgks.emplace_back(streamkgen::get_stream_k_kernelstring(hp, gg, dp));
+  }
 
   // indent the kernel strings, in case someone wants to
   // print them. For (v-minorly) better
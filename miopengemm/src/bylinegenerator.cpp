@@ -104,7 +104,7 @@ void ByLineGenerator::append_setup_coordinates(std::stringstream& ss)
 {
 
   ss << "\n\n\n/* setting up where this thread works */";
-  ss << "TINT" << MCHAR << " group_id = get_group_id(0);\n";
+  ss << "TINT" << MCHAR << " group_id = " << get_group_id_string() << ";\n";
   ss << "TSHORT local_id = (TSHORT)(get_local_id(0));\n";
   ss << "TINT" << MCHAR << " global_id = group_id*N_WORK_ITEMS_PER_GROUP + local_id;\n";
   ss << "TINT" << MCHAR << " start_uncoal = 0;\n";
@@ -176,11 +176,9 @@ w += start_coal;
 )";
 }
 
-KernBlob ByLineGenerator::get_kernelstring()
+void ByLineGenerator::append_definitions(std::stringstream& ss)
 {
 
-  std::stringstream ss;
-
   ss << get_time_string();
   append_description_string(ss);
 
@@ -195,35 +193,20 @@ KernBlob ByLineGenerator::get_kernelstring()
 
   ss << "#define TINT" << MCHAR << " " << dp.tints[emat_x] << "\n";
   ss << "#define TSHORT" << ' ' << dp.tshort << '\n';
+}
 
-  ss << "\n\n"
-     << "__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))"
-     << "\n";
-  ss << "__kernel void ";
-
-  ss << kernelname;
-  append_fargs(ss);
-
-  ss << "{";
+void ByLineGenerator::append_body(std::stringstream& ss)
+{
 
   append_setup_coordinates(ss);
   append_positioning_x_string(ss);
 
-  if (emat_x == Mat::E::A || emat_x == Mat::E::B)
+  if (u_w)
   {
     append_positioning_w_string(ss);
   }
 
   append_work_string(ss);
-
-  ss << "\n}\n\n\n";
-
-  return {get_ktype(),
-          {u_a, u_b, u_c, u_w, u_alpha, u_beta},
-          ss.str(),
-          kernelname,
-          get_global_work_size(),
-          get_local_work_size()};
 }
 }
 }
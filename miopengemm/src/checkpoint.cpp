@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <miopengemm/checkpoint.hpp>
+#include <miopengemm/error.hpp>
+
+namespace MIOpenGEMM
+{
+
+namespace
+{
+const std::string checkpoint_header = "MIOpenGEMM-find-checkpoint-1";
+
+// reads a line of the form `key value', returning value (which may contain spaces)
+std::string get_value(std::istream& is, const std::string& key, const std::string& path)
+{
+  std::string line;
+  if (!std::getline(is, line) || line.compare(0, key.size() + 1, key + ' ') != 0)
+  {
+    throw miog_error("expected `" + key + "' in checkpoint " + path + ", not `" + line + "'");
+  }
+  return line.substr(key.size() + 1);
+}
+
+size_t get_count(std::istream& is, const std::string& key, const std::string& path)
+{
+  return std::stoul(get_value(is, key, path));
+}
+
+std::tuple<HyPas, double> get_hypas_time(std::istream& is, const std::string& path)
+{
+  std::string hpstring;
+  double      time;
+  if (!(is >> hpstring >> time))
+  {
+    throw miog_error("failed to read a HyPas and time in checkpoint " + path);
+  }
+  return std::make_tuple(PackedHyPas(hpstring).get_hypas(), time);
+}
+
+void write_hypas_time(std::ostream& os, const HyPas& hp, double time)
+{
+  os << PackedHyPas(hp).get_string() << ' ' << time << '\n';
+}
+}
+
+FindCheckpoint::FindCheckpoint(const std::string& identifier_,
+                               const Geometry&    gg,
+                               const Constraints& constraints_)
+  : identifier(identifier_), geometry(gg.get_string()), constraints(constraints_.get_r_str())
+{
+}
+
+void FindCheckpoint::record(const HyPas& hp, double time) { recorded[PackedHyPas(hp)] = time; }
+
+bool FindCheckpoint::get_time(const HyPas& hp, double& time) const
+{
+  auto it = recorded.find(PackedHyPas(hp));
+  if (it == recorded.end())
+  {
+    return false;
+  }
+  time = it->second;
+  return true;
+}
+
+size_t FindCheckpoint::get_n_recorded() const { return recorded.size(); }
+
+std::vector<std::tuple<HyPas, double>> FindCheckpoint::get_recorded() const
+{
+  std::vector<std::tuple<HyPas, double>> v_recorded;
+  for (auto& x : recorded)
+  {
+    v_recorded.emplace_back(x.first.get_hypas(), x.second);
+  }
+  return v_recorded;
+}
+
+void FindCheckpoint::write(const std::string& path) const
+{
+  std::string   tmp_path = path + ".tmp";
+  std::ofstream file(tmp_path, std::ios::out | std::ios::trunc);
+  if (!file.good())
+  {
+    throw miog_error("failed to open " + tmp_path + " to write checkpoint");
+  }
+
+  // enough digits for times to be read back exactly
+  file << std::setprecision(17);
+  file << checkpoint_header << '\n'
+       << "identifier " << identifier << '\n'
+       << "geometry " << geometry << '\n'
+       << "constraints " << constraints << '\n'
+       << "tracker " << tracker_state << '\n'
+       << "random " << random_state << '\n'
+       << "warmstart_rank " << warmstart_rank << '\n';
+
+  file << "recorded " << recorded.size() << '\n';
+  for (auto& x : recorded)
+  {
+    file << x.first.get_string() << ' ' << x.second << '\n';
+  }
+
+  file << "solutions " << solutions.size() << '\n';
+  for (auto& x : solutions)
+  {
+    write_hypas_time(file, std::get<0>(x), std::get<1>(x));
+  }
+
+  file << "front " << front.size() << '\n';
+  for (auto& hp : front)
+  {
+    file << PackedHyPas(hp).get_string() << '\n';
+  }
+
+  file << "incumbent " << has_incumbent << '\n';
+  if (has_incumbent)
+  {
+    write_hypas_time(file, incumbent, incumbent_time);
+  }
+
+  file.close();
+  if (file.fail())
+  {
+    throw miog_error("failed to write checkpoint " + tmp_path);
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+  {
+    throw miog_error("failed to rename " + tmp_path + " to " + path);
+  }
+}
+
+FindCheckpoint read_checkpoint(const std::string& path)
+{
+  std::ifstream file(path);
+  if (!file.good())
+  {
+    throw miog_error("failed to open checkpoint " + path);
+  }
+
+  std::string header;
+  std::getline(file, header);
+  if (header != checkpoint_header)
+  {
+    throw miog_error(path + " is not a find checkpoint (or is of an unsupported version)");
+  }
+
+  FindCheckpoint checkpoint;
+  checkpoint.identifier     = get_value(file, "identifier", path);
+  checkpoint.geometry       = get_value(file, "geometry", path);
+  checkpoint.constraints    = get_value(file, "constraints", path);
+  checkpoint.tracker_state  = get_value(file, "tracker", path);
+  checkpoint.random_state   = get_value(file, "random", path);
+  checkpoint.warmstart_rank = get_count(file, "warmstart_rank", path);
+
+  size_t n_recorded = get_count(file, "recorded", path);
+  for (size_t i = 0; i < n_recorded; ++i)
+  {
+    auto x = get_hypas_time(file, path);
+    checkpoint.record(std::get<0>(x), std::get<1>(x));
+  }
+  file >> std::ws;
+
+  size_t n_solutions = get_count(file, "solutions", path);
+  for (size_t i = 0; i < n_solutions; ++i)
+  {
+    checkpoint.solutions.push_back(get_hypas_time(file, path));
+  }
+  file >> std::ws;
+
+  size_t n_front = get_count(file, "front", path);
+  for (size_t i = 0; i < n_front; ++i)
+  {
+    std::string hpstring;
+    file >> hpstring;
+    checkpoint.front.push_back(PackedHyPas(hpstring).get_hypas());
+  }
+  file >> std::ws;
+
+  checkpoint.has_incumbent = get_count(file, "incumbent", path) != 0;
+  if (checkpoint.has_incumbent)
+  {
+    std::tie(checkpoint.incumbent, checkpoint.incumbent_time) = get_hypas_time(file, path);
+  }
+
+  if (file.fail())
+  {
+    throw miog_error("failed to read checkpoint " + path);
+  }
+  return checkpoint;
+}
+
+FindCheckpoint read_checkpoint(const std::string& path,
+                               const std::string& identifier,
+                               const Geometry&    gg,
+                               const Constraints& constraints)
+{
+  auto checkpoint = read_checkpoint(path);
+  FindCheckpoint expected(identifier, gg, constraints);
+  for (auto& x : {std::make_tuple("device", checkpoint.identifier, expected.identifier),
+                  std::make_tuple("geometry", checkpoint.geometry, expected.geometry),
+                  std::make_tuple("constraints", checkpoint.constraints, expected.constraints)})
+  {
+    if (std::get<1>(x) != std::get<2>(x))
+    {
+      std::stringstream errm;
+      errm << "the checkpoint " << path << " is of a different " << std::get<0>(x) << " ("
+           << std::get<1>(x) << ") to this find (" << std::get<2>(x) << ')';
+      throw miog_error(errm.str());
+    }
+  }
+  return checkpoint;
+}
+}
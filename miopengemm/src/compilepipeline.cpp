@@ -0,0 +1,180 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <miopengemm/architests.hpp>
+#include <miopengemm/bundle.hpp>
+#include <miopengemm/compilepipeline.hpp>
+#include <miopengemm/error.hpp>
+
+namespace MIOpenGEMM
+{
+
+CompilePipeline::CompilePipeline(cl_device_id            device_id_,
+                                 cl_context              context_,
+                                 const Geometry&         gg_,
+                                 const oclutil::DevInfo& devinfo_,
+                                 size_t                  n_ahead_,
+                                 owrite::Writer&         mowri_)
+  : device_id(device_id_),
+    context(context_),
+    gg(gg_),
+    devinfo(devinfo_),
+    n_ahead(n_ahead_),
+    mowri(mowri_)
+{
+  if (n_ahead == 0)
+  {
+    throw miog_error("n_ahead should be strictly positive, in CompilePipeline constructor");
+  }
+
+  // no more threads than candidates which may be compiled at once
+  size_t n_hardware = std::max<size_t>(1, std::thread::hardware_concurrency());
+  size_t n_workers  = std::min(n_ahead, n_hardware);
+  for (size_t wi = 0; wi < n_workers; ++wi)
+  {
+    workers.emplace_back([this]() { work(); });
+  }
+}
+
+CompilePipeline::~CompilePipeline()
+{
+  {
+    std::lock_guard<std::mutex> lock(mut);
+    stopping = true;
+  }
+  cv_work.notify_all();
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+}
+
+void CompilePipeline::submit(const std::vector<HyPas>& front_, const std::vector<bool>& skipped_)
+{
+  if (skipped_.size() != 0 && skipped_.size() != front_.size())
+  {
+    throw miog_error("skipped should be empty or the size of front, in CompilePipeline::submit");
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mut);
+    n_cancelled += (next_to_compile - next_to_take);
+    ++generation;
+    front           = front_;
+    skipped         = skipped_.size() == 0 ? std::vector<bool>(front.size(), false) : skipped_;
+    next_to_compile = 0;
+    next_to_take    = 0;
+    ready.clear();
+    skip_to_compile();
+  }
+  cv_work.notify_all();
+}
+
+CompiledCandidate CompilePipeline::take(size_t hfi)
+{
+  std::unique_lock<std::mutex> lock(mut);
+  while (next_to_take < hfi && next_to_take < front.size() && skipped[next_to_take])
+  {
+    ++next_to_take;
+  }
+
+  if (hfi != next_to_take || hfi >= front.size() || skipped[hfi])
+  {
+    throw miog_error("candidates should be taken in order from the submitted front, "
+                     "in CompilePipeline::take");
+  }
+
+  cv_ready.wait(lock, [this, hfi]() { return ready.count(hfi) != 0; });
+  CompiledCandidate candidate = std::move(ready.at(hfi));
+  ready.erase(hfi);
+  ++next_to_take;
+  lock.unlock();
+  cv_work.notify_all();
+
+  if (candidate.error)
+  {
+    std::rethrow_exception(candidate.error);
+  }
+
+  candidate.programs.ptr_mowri = &mowri;
+  return candidate;
+}
+
+size_t CompilePipeline::get_n_cancelled() const
+{
+  std::lock_guard<std::mutex> lock(mut);
+  return n_cancelled;
+}
+
+// called with mut locked
+void CompilePipeline::skip_to_compile()
+{
+  while (next_to_compile < front.size() && skipped[next_to_compile])
+  {
+    ++next_to_compile;
+  }
+}
+
+void CompilePipeline::work()
+{
+  // workers compile silently, as their output would interleave with the benchmarking output
+  owrite::Writer worker_mowri(Ver::E::SILENT, "");
+
+  std::unique_lock<std::mutex> lock(mut);
+  while (true)
+  {
+    cv_work.wait(lock, [this]() {
+      return stopping ||
+             (next_to_compile < front.size() && next_to_compile < next_to_take + n_ahead);
+    });
+
+    if (stopping)
+    {
+      return;
+    }
+
+    size_t hfi = next_to_compile;
+    size_t gen = generation;
+    HyPas  hp  = front[hfi];
+    ++next_to_compile;
+    skip_to_compile();
+
+    lock.unlock();
+    CompiledCandidate candidate = compile(hp, worker_mowri);
+    lock.lock();
+
+    // if a new front was submitted while compiling, the candidate is discarded
+    if (gen == generation)
+    {
+      ready.emplace(hfi, std::move(candidate));
+      cv_ready.notify_all();
+    }
+  }
+}
+
+CompiledCandidate CompilePipeline::compile(const HyPas& hp, owrite::Writer& worker_mowri) const
+{
+  CompiledCandidate candidate;
+  candidate.hp = hp;
+  try
+  {
+    kerngen::Bundle bundle(hp, gg);
+    candidate.v_tgks = bundle.v_tgks;
+
+    architests::Stat atr(devinfo, bundle.dp, gg, hp);
+    candidate.is_good = atr.is_good;
+    candidate.msg     = atr.msg;
+    if (atr.is_good)
+    {
+      candidate.programs = Programs(device_id, context, worker_mowri);
+      candidate.programs.update(bundle.v_tgks);
+    }
+  }
+  catch (...)
+  {
+    candidate.error = std::current_exception();
+  }
+  return candidate;
+}
+}
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <miopengemm/architests.hpp>
+#include <miopengemm/costmodel.hpp>
+#include <miopengemm/derivedparams.hpp>
+
+namespace MIOpenGEMM
+{
+
+namespace
+{
+// Fiji : 64 compute units at 1050 MHz, 512 GB/s
+const size_t default_compute_units     = 64;
+const double default_clock_mhz         = 1050;
+const double default_gbytes_per_second = 512;
+
+// flops per clock per compute unit : 64 lanes, fused multiply-add
+const double flops_per_clock = 128;
+// floats per clock per compute unit read from LDS (128 bytes)
+const double lds_floats_per_clock = 32;
+const double simds_per_cu = 4;
+// waves per SIMD needed to hide latency
+const double latency_hiding_waves = 2;
+// [ms]
+const double launch_overhead = 0.005;
+
+double ceil_div(double a, double b) { return std::ceil(a / b); }
+}
+
+double CostEstimate::get_time() const { return std::max(compute, memory) + overhead; }
+
+std::string CostEstimate::get_string() const
+{
+  std::stringstream ss;
+  ss << "compute " << compute << " [ms]  memory " << memory << " [ms]  overhead " << overhead
+     << " [ms]  intensity " << intensity << " [flops/byte]";
+  return ss.str();
+}
+
+CostModel::CostModel(const oclutil::DevInfo& devinfo_,
+                     double                  peak_gflops_,
+                     double                  gbytes_per_second_)
+  : devinfo(devinfo_), peak_gflops(peak_gflops_), gbytes_per_second(gbytes_per_second_)
+{
+  bool is_known = devinfo.device_max_compute_units > 0 && devinfo.device_max_clock_frequency > 0;
+  compute_units = is_known ? devinfo.device_max_compute_units : default_compute_units;
+  double clock_mhz = is_known ? devinfo.device_max_clock_frequency : default_clock_mhz;
+  if (peak_gflops <= 0)
+  {
+    peak_gflops = compute_units * flops_per_clock * clock_mhz / 1000.;
+  }
+  if (gbytes_per_second <= 0)
+  {
+    gbytes_per_second = default_gbytes_per_second;
+  }
+}
+
+CostEstimate CostModel::get_estimate(const HyPas& hp, const Geometry& gg) const
+{
+  CostEstimate estimate;
+  if (!is_dvble(hp, gg))
+  {
+    estimate.compute = std::numeric_limits<double>::max();
+    return estimate;
+  }
+
+  DerivedParams         dp(hp, gg);
+  architests::Resources resources(devinfo, dp, gg, hp);
+
+  double fsize = gg.derived.float_size_bytes;
+  double mac_a = dp.at(Mat::E::A).macro_tile_length;
+  double mac_b = dp.at(Mat::E::B).macro_tile_length;
+  double mic_a = hp.sus[Mat::E::A].vs[Chi::E::MIC];
+  double mic_b = hp.sus[Mat::E::B].vs[Chi::E::MIC];
+  double unr   = hp.sus[Mat::E::C].vs[NonChi::E::UNR];
+  double ice   = hp.sus[Mat::E::C].vs[NonChi::E::ICE];
+  double n_wg  = dp.main_n_work_groups + dp.edge_n_work_groups;
+
+  // the k range of a work group, padded to the unroll
+  double k_wg = unr * ceil_div(ceil_div(gg.k, ice), unr);
+  // with Stream-K, each persistent work group has (at most) an equal share of the iterations
+  if (dp.main_stream_k == 1)
+  {
+    k_wg = unr * ceil_div(dp.main_sk_n_iterations, n_wg);
+  }
+
+  // compute : work groups run in rounds of (compute units x resident work groups), and the
+  // work groups of a compute unit share it
+  double resident = std::max<size_t>(1, resources.workgroups_per_cu);
+  double active   = std::min(resident, ceil_div(n_wg, compute_units));
+  double rounds   = ceil_div(n_wg, compute_units * resident);
+  double waves    = active * resources.waves_per_workgroup / simds_per_cu;
+  double hiding   = std::min(1., 0.5 + 0.5 * waves / latency_hiding_waves);
+  // with LDS double buffered, a work group hides its own global loads behind its math
+  if (dp.main_n_lds_buffers == 2)
+  {
+    hiding = std::min(1., 0.75 + 0.25 * waves / latency_hiding_waves);
+  }
+
+  // per work item and unroll step : mic_a x mic_b FMAs fed by mic_a + mic_b LDS reads
+  double lds_bound = std::min(
+    1., (mic_a * mic_b * lds_floats_per_clock) / ((mic_a + mic_b) * flops_per_clock / 2));
+  // the skinny kernel (GMV) reads A and B from global memory into registers, not from LDS
+  if (dp.main_skinny == 1)
+  {
+    lds_bound = 1;
+  }
+
+  double flops_wg  = 2 * mac_a * mac_b * k_wg;
+  double cu_gflops = peak_gflops / compute_units;
+  estimate.compute = rounds * active * flops_wg / (cu_gflops * hiding * lds_bound) / 1e6;
+
+  // memory : each work group reads its tiles of A and B, C is read and written (by each split
+  // in k), and a workspace copy reads and writes its matrix
+  double bytes = n_wg * (mac_a + mac_b) * k_wg * fsize / resources.load_efficiency;
+  bytes += 2 * ice * gg.m * gg.n * fsize;
+  // with partials (DSK), C is scaled by the reduce kernel instead of by a betac kernel, which
+  // also reads the partials written by the splits
+  size_t n_kernels = 1 + (dp.main_does_beta_c_inc == 0) + dp.main_interior_edge;
+  if (dp.main_split_on_k_partials == 1)
+  {
+    bytes += 2 * gg.m * gg.n * fsize;
+  }
+  // with Stream-K, the partial tiles are written and read by the fix-up kernel
+  if (dp.main_stream_k == 1)
+  {
+    bytes += 4 * n_wg * mac_a * mac_b * fsize;
+    ++n_kernels;
+  }
+  for (auto emat : {Mat::E::A, Mat::E::B})
+  {
+    if (hp.sus[emat].vs[Chi::E::WOS] != 0)
+    {
+      bytes += 2 * gg.get_non_k_dim(emat) * gg.k * fsize;
+      ++n_kernels;
+    }
+  }
+  // with workspace for both A and B, one kernel prepares both
+  n_kernels -= dp.prep_fused;
+  estimate.memory    = bytes / gbytes_per_second / 1e6;
+  estimate.overhead  = n_kernels * launch_overhead;
+  estimate.intensity = 2. * gg.m * gg.n * gg.k / bytes;
+  return estimate;
+}
+
+double CostModel::get_time(const HyPas& hp, const Geometry& gg) const
+{
+  auto estimate = get_estimate(hp, gg);
+  return estimate.compute == std::numeric_limits<double>::max() ? estimate.compute
+                                                                : estimate.get_time();
+}
+}
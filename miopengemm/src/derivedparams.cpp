@@ -2,6 +2,7 @@
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <iostream>
 #include <sstream>
@@ -23,7 +24,8 @@ std::string ChiralDerivedParams::get_string()
      << "\nmain_n_micro_tiles_pll_unroll : " << main_n_micro_tiles_pll_unroll
      << "\nmain_macro_tile_length_and_pad : " << main_macro_tile_length_and_pad
      << "\nmain_n_micro_in_macro : " << main_n_micro_in_macro
-     << "\npreshift_final_tile : " << preshift_final_tile << "\nn_groups : " << n_groups;
+     << "\npreshift_final_tile : " << preshift_final_tile << "\nn_groups : " << n_groups
+     << "\nn_interior_groups : " << n_interior_groups;
 
   return ss.str();
 }
@@ -112,10 +114,229 @@ Derivabilty::Derivabilty(const HyPas& hp, const Geometry& gg)
   msg               = std::get<1>(tup);
 }
 
+// mirrors DerivedParams::set_fragile, but only the integers which are checked are computed,
+// and no strings are constructed. Agreement with Derivabilty is checked in tests/derivability.cpp
 bool is_dvble(const HyPas& hp, const Geometry& gg)
 {
-  Derivabilty dble(hp, gg);
-  return dble.is_derivable;
+  const std::vector<size_t>& hpc = hp.sus[Mat::E::C].vs;
+  size_t                     unr = hpc[NonChi::E::UNR];
+
+  // as in set_should_be_hyperparams
+  const size_t cw2_local_work_size = 64;
+
+  std::array<size_t, 2> grid;
+  if (!macgrid::get_grid(hpc[NonChi::E::MAC], hpc[NonChi::E::SKW], grid[0], grid[1]))
+  {
+    return false;
+  }
+
+  // as in set_fragile_skinny
+  if (hpc[NonChi::E::GMV] == Binary::E::YES)
+  {
+    const std::vector<size_t>& hpa = hp.sus[Mat::E::A].vs;
+    size_t vector_length           = gg.coal_is_pll_k(Mat::E::A) ? unr : hpa[Chi::E::MIC];
+    return gg.n <= max_n_skinny && hpc[NonChi::E::ICE] == 1 &&
+           hpc[NonChi::E::GAL] != GroupAllocation::E::STREAMK &&
+           hpa[Chi::E::WOS] == Scratch::E::UNUSED &&
+           hp.sus[Mat::E::B].vs[Chi::E::WOS] == Scratch::E::UNUSED &&
+           grid[Mat::E::A] * hpa[Chi::E::MIC] <= gg.m && vector_length % hpa[Chi::E::VEW] == 0;
+  }
+
+  std::array<size_t, 2> macro_tile_length;
+  std::array<size_t, 2> n_elements_in_unroll;
+  std::array<size_t, 2> cw1_target_ldx;
+  size_t                required_workspace = 0;
+
+  size_t n_work_items_per_workgroup =
+    (grid[0] * hp.sus[Mat::E::A].vs[Chi::E::MIC] * grid[1] * hp.sus[Mat::E::B].vs[Chi::E::MIC]) /
+    (hp.sus[Mat::E::A].vs[Chi::E::MIC] * hp.sus[Mat::E::B].vs[Chi::E::MIC]);
+
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    const std::vector<size_t>& hpx = hp.sus[emat_x].vs;
+
+    macro_tile_length[emat_x] = grid[emat_x] * hpx[Chi::E::MIC];
+    size_t non_k_dim          = gg.get_non_k_dim(emat_x);
+    if (non_k_dim < macro_tile_length[emat_x])
+    {
+      return false;
+    }
+
+    n_elements_in_unroll[emat_x] = macro_tile_length[emat_x] * unr;
+
+    if (hpx[Chi::E::WOS] == Scratch::E::COPY)
+    {
+      size_t smallest_possible_ldx = gg.coal_is_pll_k(emat_x) ? gg.k : non_k_dim;
+      cw1_target_ldx[emat_x] = get_target(16, get_copy_pad(emat_x), smallest_possible_ldx);
+      required_workspace += cw1_target_ldx[emat_x] * gg.get_uncoal(emat_x);
+    }
+
+    else if (hpx[Chi::E::WOS] == Scratch::E::NFORM)
+    {
+      size_t preshift_final_tile = 1 + (non_k_dim - 1) % macro_tile_length[emat_x];
+      size_t n_groups            = non_k_dim / macro_tile_length[emat_x] +
+                        (preshift_final_tile != macro_tile_length[emat_x]);
+      required_workspace += n_groups * macro_tile_length[emat_x] * gg.k;
+    }
+
+    else if (hpx[Chi::E::WOS] != Scratch::E::UNUSED)
+    {
+      return false;
+    }
+  }
+
+  if (hpc[NonChi::E::ICE] != 1 && hpc[NonChi::E::DSK] == Binary::E::YES)
+  {
+    required_workspace += hpc[NonChi::E::ICE] * gg.ldX[Mat::E::C] * gg.get_uncoal(Mat::E::C);
+  }
+
+  if (hpc[NonChi::E::GAL] == GroupAllocation::E::STREAMK)
+  {
+    if (hpc[NonChi::E::ICE] != 1 || hpc[NonChi::E::UFO] != Binary::E::NO ||
+        hpc[NonChi::E::PWG] == 0)
+    {
+      return false;
+    }
+    size_t n_tiles = 1;
+    for (auto emat_x : {Mat::E::A, Mat::E::B})
+    {
+      n_tiles *= gg.get_non_k_dim(emat_x) / macro_tile_length[emat_x] +
+                 (gg.get_non_k_dim(emat_x) % macro_tile_length[emat_x] != 0);
+    }
+    if (hpc[NonChi::E::PWG] > n_tiles * (gg.k / unr + (gg.k % unr != 0)))
+    {
+      return false;
+    }
+    required_workspace +=
+      2 * hpc[NonChi::E::PWG] * macro_tile_length[Mat::E::A] * macro_tile_length[Mat::E::B];
+  }
+  else if (hpc[NonChi::E::PWG] != 0)
+  {
+    return false;
+  }
+
+  if (gg.wSpaceSize < required_workspace)
+  {
+    return false;
+  }
+
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    if (n_elements_in_unroll[emat_x] % n_work_items_per_workgroup != 0)
+    {
+      return false;
+    }
+
+    if (!tiling::is_tileable(macro_tile_length[emat_x],
+                             unr,
+                             n_elements_in_unroll[emat_x] / n_work_items_per_workgroup))
+    {
+      return false;
+    }
+
+    if (hp.sus[emat_x].vs[Chi::E::WOS] == Scratch::E::NFORM &&
+        (n_elements_in_unroll[emat_x] % cw2_local_work_size != 0 ||
+         !tiling::is_tileable(
+           macro_tile_length[emat_x], unr, n_elements_in_unroll[emat_x] / cw2_local_work_size)))
+    {
+      return false;
+    }
+  }
+
+  if (hpc[NonChi::E::UFO] == Binary::E::YES && gg.k <= unr)
+  {
+    return false;
+  }
+
+  if (hpc[NonChi::E::DBL] == Binary::E::YES &&
+      (hp.sus[Mat::E::A].vs[Chi::E::PRF] == Binary::E::YES ||
+       hp.sus[Mat::E::B].vs[Chi::E::PRF] == Binary::E::YES))
+  {
+    return false;
+  }
+
+  // ga3_super_column_width is floor(sqrt(NAW / ICE)) or floor(sqrt(NAW)), it must not be 0
+  if (hpc[NonChi::E::GAL] == 3)
+  {
+    if ((hpc[NonChi::E::ICE] != 1 && hpc[NonChi::E::NAW] < hpc[NonChi::E::ICE]) ||
+        hpc[NonChi::E::NAW] == 0)
+    {
+      return false;
+    }
+  }
+
+  // LDS reads wider than VEW
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    const std::vector<size_t>& hpx = hp.sus[emat_x].vs;
+    if (hpx[Chi::E::LRW] > hpx[Chi::E::VEW] &&
+        (hpx[Chi::E::MIW] != Binary::E::NO || hpx[Chi::E::MIC] % hpx[Chi::E::LRW] != 0))
+    {
+      return false;
+    }
+  }
+
+  // vectorizability
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    const std::vector<size_t>& hpx = hp.sus[emat_x].vs;
+    size_t                     vew = hpx[Chi::E::VEW];
+    if (vew == 1)
+    {
+      continue;
+    }
+
+    size_t micro_tile_perp_unroll = uninitialised_size_t;
+    size_t micro_tile_pll_unroll  = uninitialised_size_t;
+    size_t n_elements_to_load     = n_elements_in_unroll[emat_x] / n_work_items_per_workgroup;
+    if (hpx[Chi::E::PLU] == 0)
+    {
+      tiling::set_tile_dimensions_no_checks(micro_tile_perp_unroll,
+                                            micro_tile_pll_unroll,
+                                            macro_tile_length[emat_x],
+                                            unr,
+                                            n_elements_to_load);
+    }
+    else
+    {
+      tiling::set_tile_dimensions_no_checks(micro_tile_pll_unroll,
+                                            micro_tile_perp_unroll,
+                                            unr,
+                                            macro_tile_length[emat_x],
+                                            n_elements_to_load);
+    }
+
+    // strides, as in get_stride
+    size_t stride_perp_k    = 1;
+    size_t one_stride_pll_k = 1;
+    switch (hpx[Chi::E::WOS])
+    {
+    case Scratch::E::UNUSED:
+      stride_perp_k    = gg.coal_is_pll_k(emat_x) ? gg.ldX[emat_x] : 1;
+      one_stride_pll_k = gg.coal_is_pll_k(emat_x) ? 1 : gg.ldX[emat_x];
+      break;
+    case Scratch::E::COPY:
+      stride_perp_k    = gg.coal_is_pll_k(emat_x) ? cw1_target_ldx[emat_x] : 1;
+      one_stride_pll_k = gg.coal_is_pll_k(emat_x) ? 1 : cw1_target_ldx[emat_x];
+      break;
+    case Scratch::E::NFORM:
+      stride_perp_k    = 1;
+      one_stride_pll_k = macro_tile_length[emat_x];
+      break;
+    }
+
+    size_t load_stride_pll_k = hpx[Chi::E::LIW] == Binary::E::YES
+                                 ? one_stride_pll_k * (unr / micro_tile_pll_unroll)
+                                 : one_stride_pll_k;
+
+    if (stride_perp_k != 1 || micro_tile_perp_unroll % vew != 0 || hpx[Chi::E::MIC] % vew != 0 ||
+        load_stride_pll_k % vew != 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
 }
 
 DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_, std::string s)
@@ -128,11 +349,97 @@ DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_, std::string
   }
 }
 
+std::tuple<bool, std::string> DerivedParams::set_fragile_skinny()
+{
+
+  const std::vector<size_t>& hpa = ptr_hp->sus[Mat::E::A].vs;
+  const std::vector<size_t>& hpc = ptr_hp->sus[Mat::E::C].vs;
+
+  macgrid::Grid grid(hpc[NonChi::E::MAC], hpc[NonChi::E::SKW]);
+  if (!grid.is_good)
+  {
+    return std::make_tuple(false, grid.error_message);
+  }
+
+  std::stringstream set_status_ss;
+  if (ptr_gg->n > max_n_skinny)
+  {
+    set_status_ss << "GMV = yes, so n must be at most " << max_n_skinny << ". ";
+  }
+
+  // the skinny kernel is the only kernel
+  if (hpc[NonChi::E::ICE] != 1 || hpc[NonChi::E::GAL] == GroupAllocation::E::STREAMK ||
+      hpa[Chi::E::WOS] != Scratch::E::UNUSED ||
+      ptr_hp->sus[Mat::E::B].vs[Chi::E::WOS] != Scratch::E::UNUSED)
+  {
+    set_status_ss << "GMV = yes, so ICE must be 1, GAL not STREAMK and WOS of A and B 0. ";
+  }
+
+  // the grid of work items is along m (as A in the tiled kernel) and along k (as B)
+  skinny_n_work_items_pll_m = grid.at(Mat::E::A);
+  skinny_n_work_items_pll_k = grid.at(Mat::E::B);
+  if (ptr_gg->m < skinny_n_work_items_pll_m * hpa[Chi::E::MIC])
+  {
+    set_status_ss << "GMV = yes, and m is less than the rows of a work group. ";
+  }
+
+  // A is loaded VEW elements at a time, along its contiguous dimension
+  size_t vector_length =
+    ptr_gg->coal_is_pll_k(Mat::E::A) ? hpc[NonChi::E::UNR] : hpa[Chi::E::MIC];
+  if (vector_length % hpa[Chi::E::VEW] != 0)
+  {
+    set_status_ss << "GMV = yes, and VEW of A does not divide "
+                  << (ptr_gg->coal_is_pll_k(Mat::E::A) ? "UNR" : "MIC of A") << ". ";
+  }
+
+  if (set_status_ss.str() != "")
+  {
+    return std::make_tuple(false, set_status_ss.str());
+  }
+
+  main_skinny                     = 1;
+  main_n_work_items_per_workgroup = hpc[NonChi::E::MAC];
+  at(Mat::E::A).macro_tile_length = skinny_n_work_items_pll_m * hpa[Chi::E::MIC];
+  at(Mat::E::B).macro_tile_length = ptr_gg->n;
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    at(emat_x).preshift_final_tile =
+      1 + (ptr_gg->get_non_k_dim(emat_x) - 1) % at(emat_x).macro_tile_length;
+    at(emat_x).n_groups = ptr_gg->get_non_k_dim(emat_x) / at(emat_x).macro_tile_length +
+                          (at(emat_x).preshift_final_tile != at(emat_x).macro_tile_length);
+  }
+
+  // for the resource estimates : the accumulators, the fragments of A and B of an unroll in
+  // registers, and LDS only for the reduction along k
+  main_macro_tile_area = at(Mat::E::A).macro_tile_length * ptr_gg->n;
+  main_micro_tile_area = hpa[Chi::E::MIC] * ptr_gg->n;
+  at(Mat::E::A).main_n_elements_to_load_per_workitem = hpa[Chi::E::MIC] * hpc[NonChi::E::UNR];
+  at(Mat::E::B).main_n_elements_to_load_per_workitem = hpc[NonChi::E::UNR] * ptr_gg->n;
+  at(Mat::E::A).main_n_elements_in_padded_unroll =
+    skinny_n_work_items_pll_k == 1 ? 0 : main_n_work_items_per_workgroup * ptr_gg->n;
+  at(Mat::E::B).main_n_elements_in_padded_unroll = 0;
+  main_n_lds_buffers                             = 1;
+
+  main_split_on_k          = 0;
+  main_does_beta_c_inc     = 1;
+  main_split_on_k_partials = 0;
+  main_stream_k            = 0;
+  required_workspace       = 0;
+
+  return std::make_tuple(true, "");
+}
+
 std::tuple<bool, std::string> DerivedParams::set_fragile()
 {
 
   set_should_be_hyperparams();
 
+  if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::GMV] == Binary::E::YES)
+  {
+    return set_fragile_skinny();
+  }
+  main_skinny = 0;
+
   macgrid::Grid grid(ptr_hp->sus[Mat::E::C].vs[NonChi::E::MAC],
                      ptr_hp->sus[Mat::E::C].vs[NonChi::E::SKW]);
   if (!grid.is_good)
@@ -149,9 +456,11 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
       1 + (ptr_gg->get_non_k_dim(emat_x) - 1) % at(emat_x).macro_tile_length;
     at(emat_x).n_groups = ptr_gg->get_non_k_dim(emat_x) / at(emat_x).macro_tile_length +
                           (at(emat_x).preshift_final_tile != at(emat_x).macro_tile_length);
+    at(emat_x).main_lds_read_width =
+      std::max(ptr_hp->sus[emat_x].vs[Chi::E::VEW], ptr_hp->sus[emat_x].vs[Chi::E::LRW]);
     at(emat_x).main_macro_tile_length_and_pad =
       at(emat_x).macro_tile_length +
-      ptr_hp->sus[emat_x].vs[Chi::E::VEW] * ptr_hp->sus[emat_x].vs[Chi::E::PAD];
+      at(emat_x).main_lds_read_width * ptr_hp->sus[emat_x].vs[Chi::E::PAD];
 
     at(emat_x).main_n_elements_in_padded_unroll =
       at(emat_x).main_macro_tile_length_and_pad * ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR];
@@ -219,6 +528,26 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
     }
   }
 
+  // with ICE > 1 and DSK, each split in k writes its partial C to workspace, after A and B
+  if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE] != 1 &&
+      ptr_hp->sus[Mat::E::C].vs[NonChi::E::DSK] == Binary::E::YES)
+  {
+    reduce_global_offset          = required_workspace;
+    reduce_n_elements_per_partial = ptr_gg->ldX[Mat::E::C] * ptr_gg->get_uncoal(Mat::E::C);
+    required_workspace +=
+      ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE] * reduce_n_elements_per_partial;
+  }
+
+  // with GAL = STREAMK, each persistent work-group writes at most 2 partial macro tiles : of the
+  // tiles it starts and ends its iterations in
+  if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::STREAMK)
+  {
+    reduce_global_offset          = required_workspace;
+    reduce_n_elements_per_partial = adps.macro_tile_length * bdps.macro_tile_length;
+    required_workspace +=
+      2 * ptr_hp->sus[Mat::E::C].vs[NonChi::E::PWG] * reduce_n_elements_per_partial;
+  }
+
   // check -1 : enough workspace memory
   if (ptr_gg->wSpaceSize < required_workspace)
   {
@@ -301,8 +630,54 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
     }
   }
 
+  // both overlap the global loads of the next unroll with the math, and are not combined
+  if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::DBL] == Binary::E::YES)
+  {
+    for (auto emat_x : {Mat::E::A, Mat::E::B})
+    {
+      if (ptr_hp->sus[emat_x].vs[Chi::E::PRF] == Binary::E::YES)
+      {
+        return std::make_tuple(false, "DBL = yes, so PRF of A and B must be no");
+      }
+    }
+  }
+
+  main_n_lds_buffers = ptr_hp->sus[Mat::E::C].vs[NonChi::E::DBL] == Binary::E::YES ? 2 : 1;
+
   main_split_on_k      = ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE] == 1 ? 0 : 1;
   main_does_beta_c_inc = main_split_on_k == 1 ? 0 : 1;
+  main_split_on_k_partials =
+    (main_split_on_k == 1 && ptr_hp->sus[Mat::E::C].vs[NonChi::E::DSK] == Binary::E::YES) ? 1 : 0;
+
+  main_stream_k =
+    ptr_hp->sus[Mat::E::C].vs[NonChi::E::GAL] == GroupAllocation::E::STREAMK ? 1 : 0;
+  if (main_stream_k == 1)
+  {
+    if (main_split_on_k == 1 || ptr_hp->sus[Mat::E::C].vs[NonChi::E::UFO] != Binary::E::NO)
+    {
+      return std::make_tuple(false, "GAL = STREAMK, so ICE must be 1 and UFO must be no");
+    }
+
+    if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::PWG] == 0)
+    {
+      return std::make_tuple(false, "GAL = STREAMK, so PWG must be positive");
+    }
+
+    size_t unr                  = ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR];
+    main_sk_iterations_per_tile = ptr_gg->k / unr + (ptr_gg->k % unr != 0);
+    main_sk_n_iterations        = adps.n_groups * bdps.n_groups * main_sk_iterations_per_tile;
+
+    // so that every persistent work-group has at least one iteration
+    if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::PWG] > main_sk_n_iterations)
+    {
+      return std::make_tuple(false, "PWG is larger than the number of (tile, unroll) iterations");
+    }
+  }
+  // so that HyPas which differ only in an unused PWG are not distinct
+  else if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::PWG] != 0)
+  {
+    return std::make_tuple(false, "GAL is not STREAMK, so PWG must be 0");
+  }
 
   if (ptr_hp->sus[Mat::E::C].vs[NonChi::E::GAL] == 3)
   {
@@ -416,6 +791,26 @@ std::tuple<bool, std::string> DerivedParams::set_fragile()
     }
   }
 
+  // reads from LDS wider than VEW : the micro tile must be contiguous in LDS, and aligned
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    if (at(emat_x).main_lds_read_width != ptr_hp->sus[emat_x].vs[Chi::E::VEW])
+    {
+      if (ptr_hp->sus[emat_x].vs[Chi::E::MIW] != Binary::E::NO)
+      {
+        ss_viz << "LRW of " << Mat::M().name[emat_x] << " exceeds VEW, so MIW should be 0.\n";
+        is_viz = false;
+      }
+
+      if (ptr_hp->sus[emat_x].vs[Chi::E::MIC] % at(emat_x).main_lds_read_width != 0)
+      {
+        ss_viz << "micro tile dim-" << Mat::M().name[emat_x] << " ( "
+               << ptr_hp->sus[emat_x].vs[Chi::E::MIC] << " )  is not divisable by LRW.\n";
+        is_viz = false;
+      }
+    }
+  }
+
   std::string viza = ss_viz.str();
 
   if (!is_viz)
@@ -488,6 +883,12 @@ DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_) : ptr_hp(&hp
     fati = "n_work_items_per_c_elm is 1, should not be using atomics";
   }
 
+  else if (main_split_on_k_partials == 1)
+  {
+    infa = "partial tiles are reduced in a separate kernel, should not be using atomics";
+    fati = "partial tiles are reduced in a separate kernel, should not be using atomics";
+  }
+
   else
   {
     infa = ptr_gg->derived.float_size_bits == 32 ? "uint" : "ulong";
@@ -510,12 +911,43 @@ DerivedParams::DerivedParams(const HyPas& hp_, const Geometry& gg_) : ptr_hp(&hp
                        ((ptr_gg->n / at(Mat::E::B).macro_tile_length) +
                         (ptr_gg->n % at(Mat::E::B).macro_tile_length != 0));
 
+  if (main_stream_k == 1)
+  {
+    main_n_work_groups = ptr_hp->sus[Mat::E::C].vs[NonChi::E::PWG];
+  }
+
   main_global_work_size = main_n_work_groups * main_n_work_items_per_workgroup;
 
   main_use_edge_trick = (ptr_gg->m % at(Mat::E::A).macro_tile_length == 0 &&
                          ptr_gg->n % at(Mat::E::B).macro_tile_length == 0)
                           ? 0
                           : 1;
+
+  for (auto emat_x : {Mat::E::A, Mat::E::B})
+  {
+    at(emat_x).n_interior_groups =
+      at(emat_x).n_groups - (at(emat_x).preshift_final_tile != at(emat_x).macro_tile_length);
+  }
+
+  // with IEK, MAIN processes the interior tiles and EDGE the others. The skinny kernel and
+  // Stream-K ignore IEK
+  main_interior_edge = (ptr_hp->sus[Mat::E::C].vs[NonChi::E::IEK] == Binary::E::YES &&
+                        main_use_edge_trick == 1 && main_skinny == 0 && main_stream_k == 0)
+                         ? 1
+                         : 0;
+  edge_n_work_groups    = 0;
+  edge_global_work_size = 0;
+  if (main_interior_edge == 1)
+  {
+    size_t n_interior_work_groups = ptr_hp->sus[Mat::E::C].vs[NonChi::E::ICE] *
+                                    at(Mat::E::A).n_interior_groups *
+                                    at(Mat::E::B).n_interior_groups;
+    edge_n_work_groups    = main_n_work_groups - n_interior_work_groups;
+    edge_global_work_size = edge_n_work_groups * main_n_work_items_per_workgroup;
+    main_n_work_groups    = n_interior_work_groups;
+    main_global_work_size = main_n_work_groups * main_n_work_items_per_workgroup;
+  }
+
   main_final_fractional_unroll = (ptr_hp->sus[Mat::E::C].vs[NonChi::E::UFO] == 1 ||
                                   ptr_gg->k % ptr_hp->sus[Mat::E::C].vs[NonChi::E::UNR] != 0)
                                    ? 1
@@ -551,6 +983,9 @@ void DerivedParams::set_should_be_hyperparams()
   betac_local_work_size = 256;
   betac_work_per_thread = 2;
 
+  reduce_local_work_size = 256;
+  reduce_work_per_thread = 2;
+
   for (auto emat_x : {Mat::E::A, Mat::E::B})
   {
 
@@ -559,6 +994,18 @@ void DerivedParams::set_should_be_hyperparams()
     at(emat_x).cw2_load_pll_to_unroll = 0;
     at(emat_x).cw2_local_work_size    = 64;
   }
+
+  size_t wos_a = ptr_hp->sus[Mat::E::A].vs[Chi::E::WOS];
+  size_t wos_b = ptr_hp->sus[Mat::E::B].vs[Chi::E::WOS];
+  prep_fused   = (wos_a != Scratch::E::UNUSED && wos_b != Scratch::E::UNUSED) ? 1 : 0;
+  // the fused kernel has one work group size. The normal form's is constrained (tileability)
+  if (prep_fused == 1 && wos_a != wos_b)
+  {
+    for (auto emat_x : {Mat::E::A, Mat::E::B})
+    {
+      at(emat_x).cw1_local_work_size = at(emat_x).cw2_local_work_size;
+    }
+  }
 }
 
 size_t
@@ -135,10 +135,13 @@ namespace KType
 std::vector<std::string> get_name()
 {
   std::vector<std::string> X(E::N, unfilled<std::string>());
-  X[E::WSA]   = "WSA";
-  X[E::WSB]   = "WSB";
-  X[E::BETAC] = "BETAC";
-  X[E::MAIN]  = "MAIN";
+  X[E::WSA]    = "WSA";
+  X[E::WSB]    = "WSB";
+  X[E::WSAB]   = "WSAB";
+  X[E::BETAC]  = "BETAC";
+  X[E::MAIN]   = "MAIN";
+  X[E::EDGE]   = "EDGE";
+  X[E::REDUCE] = "REDUCE";
   return X;
 }
 
@@ -167,6 +170,42 @@ const EnumMapper<std::string>& M()
 }
 }
 
+namespace SearchType
+{
+std::vector<std::string> get_name()
+{
+  std::vector<std::string> X(E::N, unfilled<std::string>());
+  X[E::DESCENT]   = "DESCENT";
+  X[E::SURROGATE] = "SURROGATE";
+  X[E::EVOLUTION] = "EVOLUTION";
+  return X;
+}
+
+const EnumMapper<std::string>& M()
+{
+  static const EnumMapper<std::string> em = get_enum_mapper<std::string>(get_name(), "SearchType");
+  return em;
+}
+}
+
+namespace RobustObjective
+{
+std::vector<std::string> get_name()
+{
+  std::vector<std::string> X(E::N, unfilled<std::string>());
+  X[E::WEIGHTED_TIME]  = "WEIGHTED_TIME";
+  X[E::WORST_SLOWDOWN] = "WORST_SLOWDOWN";
+  return X;
+}
+
+const EnumMapper<std::string>& M()
+{
+  static const EnumMapper<std::string> em =
+    get_enum_mapper<std::string>(get_name(), "RobustObjective");
+  return em;
+}
+}
+
 namespace Xtr
 {
 std::vector<std::string> get_name()
@@ -230,6 +269,8 @@ std::vector<std::string> get_name()
   X[E::MIW] = "MIW";
   X[E::WOS] = "WOS";
   X[E::VEW] = "VEW";
+  X[E::PRF] = "PRF";
+  X[E::LRW] = "LRW";
   return X;
 }
 
@@ -243,6 +284,16 @@ std::vector<int> get_priority_basic()
   X[E::MIW] = 0;
   X[E::WOS] = 0;
   X[E::VEW] = 0;
+  X[E::PRF] = 0;
+  X[E::LRW] = 0;
+  return X;
+}
+
+std::vector<size_t> get_omitted_basic()
+{
+  std::vector<size_t> X(E::N, Status::E::UNDEFINED);
+  X[E::PRF] = Binary::E::NO;
+  X[E::LRW] = 1;
   return X;
 }
 
@@ -257,6 +308,12 @@ const std::vector<int>& get_priority()
   const static std::vector<int> priority = get_priority_confirmed(get_priority_basic(), E::N);
   return priority;
 }
+
+const std::vector<size_t>& get_omitted()
+{
+  const static std::vector<size_t> omitted = get_omitted_basic();
+  return omitted;
+}
 }
 
 namespace OutPart
@@ -325,6 +382,11 @@ std::vector<std::string> get_name()
   X[E::MAD] = "MAD";
   X[E::AFI] = "AFI";
   X[E::MIA] = "MIA";
+  X[E::DBL] = "DBL";
+  X[E::DSK] = "DSK";
+  X[E::PWG] = "PWG";
+  X[E::GMV] = "GMV";
+  X[E::IEK] = "IEK";
   return X;
 }
 
@@ -344,6 +406,22 @@ std::vector<int> get_priority_basic()
   X[E::AFI] = -1;
   X[E::MIA] = -1;
   X[E::SZT] = -1;
+  X[E::DBL] = 0;
+  X[E::DSK] = 0;
+  X[E::PWG] = 0;
+  X[E::GMV] = 0;
+  X[E::IEK] = 0;
+  return X;
+}
+
+std::vector<size_t> get_omitted_basic()
+{
+  std::vector<size_t> X(E::N, Status::E::UNDEFINED);
+  X[E::DBL] = Binary::E::NO;
+  X[E::DSK] = Binary::E::NO;
+  X[E::PWG] = 0;
+  X[E::GMV] = Binary::E::NO;
+  X[E::IEK] = Binary::E::NO;
   return X;
 }
 
@@ -358,6 +436,12 @@ const std::vector<int>& get_priority()
   const static std::vector<int> prty = get_priority_confirmed(get_priority_basic(), E::N);
   return prty;
 }
+
+const std::vector<size_t>& get_omitted()
+{
+  const static std::vector<size_t> omitted = get_omitted_basic();
+  return omitted;
+}
 }
 
 namespace Mat
@@ -401,6 +485,18 @@ const std::vector<int>* mat_to_priority(Mat::E emat)
   throw miog_error("failed in mat_to_priority");
 }
 
+const std::vector<size_t>* mat_to_omitted(Mat::E emat)
+{
+  switch (emat)
+  {
+  case Mat::E::A: return &Chi::get_omitted();
+  case Mat::E::B: return &Chi::get_omitted();
+  case Mat::E::C: return &NonChi::get_omitted();
+  case Mat::E::N: throw miog_error("unrecognised Mat::E (N) in mat_to_omitted");
+  }
+  throw miog_error("failed in mat_to_omitted");
+}
+
 Mat::E mem_to_mat(Mem::E emat)
 {
   switch (emat)
@@ -467,10 +563,15 @@ std::array<std::vector<size_t>, E::N> get_dependencies_basic()
   {
     kdps[i] = uninitialised_vector;
   }
-  kdps[E::WSA]   = {};
-  kdps[E::WSB]   = {};
-  kdps[E::BETAC] = {};
-  kdps[E::MAIN]  = {E::BETAC, E::WSA, E::WSB};
+  kdps[E::WSA]    = {};
+  kdps[E::WSB]    = {};
+  kdps[E::WSAB]   = {};
+  kdps[E::BETAC]  = {};
+  kdps[E::MAIN]   = {E::BETAC, E::WSA, E::WSB, E::WSAB};
+  // EDGE and MAIN write disjoint tiles of C. EDGE waits for MAIN so that the final kernel's event
+  // (the user's event) marks the completion of all of C
+  kdps[E::EDGE]   = {E::BETAC, E::WSA, E::WSB, E::WSAB, E::MAIN};
+  kdps[E::REDUCE] = {E::MAIN, E::EDGE};
 
   for (auto& x : kdps)
   {
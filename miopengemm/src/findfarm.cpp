@@ -0,0 +1,461 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include <miopengemm/error.hpp>
+#include <miopengemm/findfarm.hpp>
+#include <miopengemm/packedhypas.hpp>
+#include <miopengemm/redirection.hpp>
+#include <miopengemm/timer.hpp>
+#include <miopengemm/tinytwo.hpp>
+
+namespace MIOpenGEMM
+{
+
+FarmJob::FarmJob(const Geometry& gg_, const Constraints& constraints_)
+  : gg(gg_), constraints(constraints_)
+{
+}
+
+std::string FarmJob::get_string() const
+{
+  return gg.get_string() + " (constraints " + constraints.get_string() + ")";
+}
+
+TuningDatabase::Entry::Entry(const std::string& device_,
+                             const Constraints& constraints_,
+                             const Geometry&    gg_,
+                             const HyPas&       hypas_,
+                             double             extime_)
+  : device(device_), constraints(constraints_), gg(gg_), hypas(hypas_), extime(extime_)
+{
+}
+
+bool TuningDatabase::add(const Entry& entry)
+{
+  // equivalent (non-canonical) problems share a key
+  std::string key = CacheKey(entry.device, entry.constraints, entry.gg).concatenated;
+  auto        it  = entries.find(key);
+  if (it == entries.end())
+  {
+    entries.emplace(key, entry);
+    return true;
+  }
+  if (entry.extime < it->second.extime)
+  {
+    it->second = entry;
+    return true;
+  }
+  return false;
+}
+
+bool TuningDatabase::add(const FarmResult& result)
+{
+  if (!result.is_found)
+  {
+    throw miog_error("only found results can be added to a TuningDatabase");
+  }
+  return add({result.device, result.job.constraints, result.job.gg, result.hypas, result.extime});
+}
+
+void TuningDatabase::merge(const TuningDatabase& other)
+{
+  for (auto& x : other.entries)
+  {
+    add(x.second);
+  }
+}
+
+std::vector<TuningDatabase::Entry> TuningDatabase::get_entries() const
+{
+  std::vector<Entry> v_entries;
+  for (auto& x : entries)
+  {
+    v_entries.push_back(x.second);
+  }
+  return v_entries;
+}
+
+KernelCache TuningDatabase::get_kernel_cache() const
+{
+  KernelCache kc;
+  for (auto& x : entries)
+  {
+    auto& entry   = x.second;
+    bool  swap_ab = redirection::get_is_not_canonical(entry.gg);
+    kc.add({entry.device, entry.constraints, entry.gg}, entry.hypas.get_reflected(swap_ab));
+  }
+  return kc;
+}
+
+std::string TuningDatabase::get_cache_entries_string() const
+{
+  std::stringstream ss;
+  for (auto& x : entries)
+  {
+    auto& entry   = x.second;
+    bool  swap_ab = redirection::get_is_not_canonical(entry.gg);
+    ss << get_cache_entry_string({entry.device, entry.constraints, entry.gg}, entry.hypas, swap_ab)
+       << '\n';
+  }
+  return ss.str();
+}
+
+void TuningDatabase::write(const std::string& path) const
+{
+  std::string   tmp_path = path + ".tmp";
+  std::ofstream file(tmp_path, std::ios::out | std::ios::trunc);
+  if (!file.good())
+  {
+    throw miog_error("failed to open " + tmp_path + " to write tuning database");
+  }
+
+  file << std::setprecision(17);
+  for (auto& x : entries)
+  {
+    auto& entry = x.second;
+    file << entry.device << '\t' << entry.constraints.get_string() << '\t'
+         << entry.gg.get_string() << '\t' << PackedHyPas(entry.hypas).get_string() << '\t'
+         << entry.extime << '\n';
+  }
+
+  file.close();
+  if (file.fail())
+  {
+    throw miog_error("failed to write tuning database " + tmp_path);
+  }
+
+  if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+  {
+    throw miog_error("failed to rename " + tmp_path + " to " + path);
+  }
+}
+
+TuningDatabase read_tuning_database(const std::string& path)
+{
+  TuningDatabase database;
+  std::ifstream  file(path);
+  if (!file.good())
+  {
+    return database;
+  }
+
+  std::string line;
+  while (std::getline(file, line))
+  {
+    if (line == "")
+    {
+      continue;
+    }
+    // constraints may be empty, so fields are not split with stringutil::split
+    std::vector<std::string> frags;
+    std::stringstream        ss(line);
+    std::string              frag;
+    while (std::getline(ss, frag, '\t'))
+    {
+      frags.push_back(frag);
+    }
+    if (frags.size() != 5)
+    {
+      throw miog_error("expected 5 tab-separated fields in tuning database " + path + ", not `" +
+                       line + "'");
+    }
+    database.add({frags[0],
+                  Constraints(frags[1]),
+                  Geometry(frags[2]),
+                  PackedHyPas(frags[3]).get_hypas(),
+                  std::stod(frags[4])});
+  }
+  return database;
+}
+
+#ifndef _WIN32
+namespace
+{
+
+// a worker process running a job
+class Worker
+{
+  public:
+  bool        is_busy{false};
+  pid_t       pid{0};
+  int         fd{-1};
+  size_t      ji{0};
+  Timer       timer;
+  std::string output;
+
+  // appends what the process has written so far to output
+  void drain()
+  {
+    char    buffer[4096];
+    ssize_t n_read;
+    while ((n_read = read(fd, buffer, sizeof(buffer))) > 0)
+    {
+      output.append(buffer, static_cast<size_t>(n_read));
+    }
+  }
+};
+
+// Runs in the forked process. The outcome of the find is written to fd, as
+// `found\ndevice\nhypas\nextime' or `failed\nmessage'.
+void run_job(const FarmJob&                             job,
+             const CLHint&                              hint,
+             const FindParams&                          fparms,
+             const std::function<void(const FarmJob&)>& setup,
+             const std::string&                         log,
+             int                                        fd)
+{
+  std::stringstream ss;
+  int               status = 0;
+  try
+  {
+    if (setup)
+    {
+      setup(job);
+    }
+    owrite::Writer mowri(log == "" ? Ver::E::SILENT : Ver::E::TOFILE, log);
+    dev::TinyTwo   boa(job.gg, get_zero_offsets(), mowri, hint);
+    auto           soln = boa.find2(fparms, job.constraints);
+    ss << "found\n"
+       << soln.devinfo.identifier << '\n'
+       << PackedHyPas(soln.hypas).get_string() << '\n'
+       << std::setprecision(17) << soln.extime;
+  }
+  catch (const std::exception& e)
+  {
+    ss << "failed\n" << e.what();
+    status = 1;
+  }
+
+  std::string output = ss.str();
+  size_t      n_done = 0;
+  while (n_done < output.size())
+  {
+    ssize_t n_written = write(fd, output.data() + n_done, output.size() - n_done);
+    if (n_written <= 0)
+    {
+      break;
+    }
+    n_done += static_cast<size_t>(n_written);
+  }
+  close(fd);
+  // no static destructors or atexit handlers of the farm in the worker
+  _exit(status);
+}
+
+// sets result from what the worker wrote and how it exited. Returns false if it crashed.
+bool set_result(FarmResult& result, const std::string& output, int wstatus)
+{
+  std::stringstream ss(output);
+  std::string       outcome;
+  std::getline(ss, outcome);
+
+  if (outcome == "found")
+  {
+    std::string hpstring;
+    std::string extime;
+    std::getline(ss, result.device);
+    std::getline(ss, hpstring);
+    std::getline(ss, extime);
+    result.is_found = true;
+    result.hypas    = PackedHyPas(hpstring).get_hypas();
+    result.extime   = std::stod(extime);
+    result.message  = "";
+    return true;
+  }
+
+  if (outcome == "failed")
+  {
+    result.message = output.substr(outcome.size() + 1);
+    return true;
+  }
+
+  std::stringstream errm;
+  if (WIFSIGNALED(wstatus))
+  {
+    errm << "worker killed by signal " << WTERMSIG(wstatus) << " (" << strsignal(WTERMSIG(wstatus))
+         << ')';
+  }
+  else
+  {
+    errm << "worker exited with status " << WEXITSTATUS(wstatus) << " without a result";
+  }
+  result.message = errm.str();
+  return false;
+}
+}
+#endif
+
+FindFarm::FindFarm(const FarmParams& params_, owrite::Writer& mowri_)
+  : params(params_), mowri(mowri_)
+{
+  if (params.devices.size() == 0)
+  {
+    throw miog_error("FindFarm requires at least one device");
+  }
+  if (params.max_attempts == 0)
+  {
+    throw miog_error("max_attempts should be strictly positive, in FindFarm");
+  }
+}
+
+#ifdef _WIN32
+std::vector<FarmResult> FindFarm::run(const std::vector<FarmJob>&)
+{
+  throw miog_error("FindFarm runs its jobs in forked worker processes, which are not supported on "
+                   "Windows");
+}
+#else
+std::vector<FarmResult> FindFarm::run(const std::vector<FarmJob>& jobs)
+{
+  if (params.database_path != "")
+  {
+    database.merge(read_tuning_database(params.database_path));
+  }
+
+  std::vector<FarmResult> results;
+  std::deque<size_t>      queue;
+  for (size_t ji = 0; ji < jobs.size(); ++ji)
+  {
+    results.emplace_back(jobs[ji]);
+    queue.push_back(ji);
+  }
+
+  std::vector<Worker> workers(params.devices.size());
+  size_t              n_done = 0;
+
+  auto get_prefix = [&jobs, &n_done](size_t ji, size_t wi) {
+    std::stringstream ss;
+    ss << '[' << n_done << '/' << jobs.size() << ", job " << ji << ", worker " << wi << "] ";
+    return ss.str();
+  };
+
+  while (n_done < jobs.size())
+  {
+    for (size_t wi = 0; wi < workers.size(); ++wi)
+    {
+      auto& worker = workers[wi];
+      if (worker.is_busy || queue.size() == 0)
+      {
+        continue;
+      }
+
+      size_t ji = queue.front();
+      queue.pop_front();
+      ++results[ji].attempts;
+
+      int fds[2];
+      if (pipe(fds) != 0)
+      {
+        throw miog_error("failed to create a pipe for a FindFarm worker");
+      }
+
+      std::string log =
+        params.logdir == "" ? "" : params.logdir + "job_" + std::to_string(ji) + ".txt";
+
+      mowri << get_prefix(ji, wi) << "starting " << jobs[ji].get_string() << Endl;
+
+      // flushing, so that the worker does not inherit (and repeat) buffered output
+      std::fflush(nullptr);
+      pid_t pid = fork();
+      if (pid < 0)
+      {
+        throw miog_error("failed to fork a FindFarm worker");
+      }
+
+      if (pid == 0)
+      {
+        close(fds[0]);
+        run_job(jobs[ji], params.devices[wi], params.find_params, params.worker_setup, log, fds[1]);
+      }
+
+      close(fds[1]);
+      fcntl(fds[0], F_SETFL, O_NONBLOCK);
+      worker.is_busy = true;
+      worker.pid     = pid;
+      worker.fd      = fds[0];
+      worker.ji      = ji;
+      worker.output  = "";
+      worker.timer.start();
+    }
+
+    for (size_t wi = 0; wi < workers.size(); ++wi)
+    {
+      auto& worker = workers[wi];
+      if (!worker.is_busy)
+      {
+        continue;
+      }
+
+      worker.drain();
+      int   wstatus = 0;
+      pid_t waited  = waitpid(worker.pid, &wstatus, WNOHANG);
+      bool  timeout = false;
+      if (waited == 0)
+      {
+        if (worker.timer.get_elapsed() < params.job_timeout)
+        {
+          continue;
+        }
+        kill(worker.pid, SIGKILL);
+        waitpid(worker.pid, &wstatus, 0);
+        timeout = true;
+      }
+
+      worker.drain();
+      close(worker.fd);
+      worker.is_busy = false;
+
+      auto& result   = results[worker.ji];
+      result.seconds = worker.timer.get_elapsed();
+      bool completed = timeout ? false : set_result(result, worker.output, wstatus);
+      if (timeout)
+      {
+        result.message = "timed out after " + std::to_string(params.job_timeout) + " seconds";
+      }
+
+      if (!completed && result.attempts < params.max_attempts)
+      {
+        mowri << get_prefix(worker.ji, wi) << result.message << ", will retry" << Endl;
+        queue.push_back(worker.ji);
+        continue;
+      }
+
+      ++n_done;
+      if (result.is_found)
+      {
+        mowri << get_prefix(worker.ji, wi) << result.job.gg.get_gflops(result.extime / 1000.)
+              << " gflops on " << result.device << " in " << result.seconds << " seconds : "
+              << result.hypas.get_string() << Endl;
+        if (database.add(result) && params.database_path != "")
+        {
+          database.write(params.database_path);
+        }
+      }
+      else
+      {
+        mowri << get_prefix(worker.ji, wi) << "failed : " << result.message << Endl;
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+
+  return results;
+}
+#endif
+}
@@ -1,6 +1,9 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <sstream>
 #include <miopengemm/enums.hpp>
 #include <miopengemm/error.hpp>
@@ -67,6 +70,190 @@ std::string Halt::get_string() const
   return ss.str();
 }
 
+Racing::Racing(size_t min_runs_, double margin_, double z_, size_t batch_size_)
+  : enabled(true), min_runs(min_runs_), margin(margin_), z(z_), batch_size(batch_size_)
+{
+  if (min_runs < 2)
+  {
+    throw miog_error("min_runs should be at least 2 (for a variance), in Racing constructor");
+  }
+
+  if (margin < 0 || z < 0)
+  {
+    throw miog_error("margin and z should be non-negative, in Racing constructor");
+  }
+
+  if (batch_size == 0)
+  {
+    throw miog_error("batch_size should be strictly positive, in Racing constructor");
+  }
+}
+
+double Racing::get_lower_bound(const std::vector<double>& times) const
+{
+  if (times.size() == 0)
+  {
+    throw miog_error("no times, in Racing::get_lower_bound");
+  }
+
+  double n    = static_cast<double>(times.size());
+  double mean = 0;
+  for (auto& x : times)
+  {
+    mean += x / n;
+  }
+
+  double var = 0;
+  for (auto& x : times)
+  {
+    var += (x - mean) * (x - mean) / std::max(1.0, n - 1);
+  }
+
+  double fastest = *std::min_element(times.begin(), times.end());
+  return std::min(fastest, mean - z * std::sqrt(var / n));
+}
+
+bool Racing::is_hopeless(const std::vector<double>& times, double incumbent) const
+{
+  if (!enabled || times.size() < min_runs)
+  {
+    return false;
+  }
+  return get_lower_bound(times) > (1 + margin) * incumbent;
+}
+
+std::string Racing::get_string() const
+{
+  if (!enabled)
+  {
+    return "(not racing)";
+  }
+  std::stringstream ss;
+  ss << "(min_runs " << min_runs << ") (margin " << margin << ") (z " << z << ") (batch_size "
+     << batch_size << ')';
+  return ss.str();
+}
+
+Noise::Noise(size_t warmup_, double outlier_k_, size_t n_interleaved_, double confidence_)
+  : enabled(true),
+    warmup(warmup_),
+    outlier_k(outlier_k_),
+    n_interleaved(n_interleaved_),
+    confidence(confidence_)
+{
+  if (outlier_k < 0)
+  {
+    throw miog_error("outlier_k should be non-negative, in Noise constructor");
+  }
+
+  if (confidence <= 0.5 || confidence >= 1)
+  {
+    throw miog_error("confidence should be in (0.5, 1), in Noise constructor");
+  }
+}
+
+std::string Noise::get_string() const
+{
+  if (!enabled)
+  {
+    return "(no noise control)";
+  }
+  std::stringstream ss;
+  ss << "(warmup " << warmup << ") (outlier_k " << outlier_k << ") (n_interleaved "
+     << n_interleaved << ") (confidence " << confidence << ')';
+  return ss.str();
+}
+
+Repeats::Repeats(double min_run_time_, size_t max_launches_)
+  : enabled(true), min_run_time(min_run_time_), max_launches(max_launches_)
+{
+  if (min_run_time <= 0)
+  {
+    throw miog_error("min_run_time should be strictly positive, in Repeats constructor");
+  }
+
+  if (max_launches < 2)
+  {
+    throw miog_error("max_launches should be at least 2, in Repeats constructor");
+  }
+}
+
+std::string Repeats::get_string() const
+{
+  if (!enabled)
+  {
+    return "(single launches)";
+  }
+  std::stringstream ss;
+  ss << "(min_run_time " << min_run_time << ") (max_launches " << max_launches << ')';
+  return ss.str();
+}
+
+Amortisation::Amortisation(double invocations_, double default_time_)
+  : invocations(invocations_), default_time(default_time_)
+{
+}
+
+void Amortisation::record(double elapsed, double best_time)
+{
+  if (best_time < get_best_time())
+  {
+    history.emplace_back(elapsed, best_time);
+  }
+}
+
+double Amortisation::get_best_time(double elapsed) const
+{
+  double best_time = default_time;
+  for (auto& x : history)
+  {
+    if (std::get<0>(x) <= elapsed)
+    {
+      best_time = std::get<1>(x);
+    }
+  }
+  return best_time;
+}
+
+double Amortisation::get_best_time() const
+{
+  return history.size() == 0 ? default_time : std::get<1>(history.back());
+}
+
+bool Amortisation::halt(double elapsed) const
+{
+  if (!is_enabled() || elapsed < min_elapsed)
+  {
+    return false;
+  }
+
+  // [ms]
+  double cost = 1000 * elapsed;
+  if (cost >= invocations * default_time)
+  {
+    return true;
+  }
+
+  double recent_saving = invocations * (get_best_time(elapsed / 2) - get_best_time());
+  return recent_saving < cost / 2;
+}
+
+double Amortisation::get_break_even(double elapsed) const
+{
+  double saving_per_invocation = default_time - get_best_time();
+  return saving_per_invocation > 0 ? 1000 * elapsed / saving_per_invocation
+                                   : std::numeric_limits<double>::infinity();
+}
+
+std::string Amortisation::get_string(double elapsed) const
+{
+  std::stringstream ss;
+  ss << "default " << default_time << " [ms], best " << get_best_time()
+     << " [ms], break-even after " << get_break_even(elapsed) << " of " << invocations
+     << " expected invocations";
+  return ss.str();
+}
+
 std::vector<std::string> get_sumstatkeys_basic()
 {
   std::vector<std::string> ssv(SummStat::E::N, "unset");
@@ -113,7 +300,22 @@ std::string FindParams::get_string() const
 {
   std::stringstream ss;
   ss << "(OUTER)   " << hl_outer.get_string() << "(INNER)   " << hl_core.get_string()
-     << "(SUMSTAT) " << get_sumstatkey(sumstat);
+     << "(SUMSTAT) " << get_sumstatkey(sumstat) << "   (COMPILE AHEAD) " << n_compile_ahead
+     << "   (RACING) " << racing.get_string() << "   (NOISE) " << noise.get_string()
+     << "   (REPEATS) " << repeats.get_string() << "   (SEARCH) " << SearchType::M().name[search]
+     << "   (PER ROUND) " << n_per_round << "   (COST ORDERED) " << cost_ordered;
+  if (checkpoint_path != "")
+  {
+    ss << "   (CHECKPOINT) " << checkpoint_path << " every " << checkpoint_interval << "s";
+  }
+  if (resume_path != "")
+  {
+    ss << "   (RESUME) " << resume_path;
+  }
+  if (amortisation.is_enabled())
+  {
+    ss << "   (AMORTISED) " << amortisation.invocations << " invocations";
+  }
   return ss.str();
 }
 
@@ -127,6 +329,14 @@ FindParams get_at_least_n_seconds(double seconds)
   return FindParams(descents, time_outer, per_kernel, time_core, sumstat);
 }
 
+FindParams get_amortised(double invocations, double default_time, double max_seconds)
+{
+  auto fparms         = get_at_least_n_seconds(max_seconds);
+  fparms.hl_outer     = Halt({{0, 100000}}, {{0, max_seconds}});
+  fparms.amortisation = Amortisation(invocations, default_time);
+  return fparms;
+}
+
 FindParams get_at_least_n_restarts(size_t restarts)
 {
   std::array<size_t, Xtr::E::N> descents{{restarts, restarts}};
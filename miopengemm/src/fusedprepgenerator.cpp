@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <array>
+#include <memory>
+#include <sstream>
+#include <miopengemm/copygenerator.hpp>
+#include <miopengemm/error.hpp>
+#include <miopengemm/fusedprepgenerator.hpp>
+#include <miopengemm/normalformgenerator.hpp>
+#include <miopengemm/stringutilbase.hpp>
+
+namespace MIOpenGEMM
+{
+namespace fusedprepgen
+{
+
+class FusedPrepGenerator : public basegen::BaseGenerator
+{
+
+  private:
+  std::array<std::unique_ptr<prepgen::PrepGenerator>, 2> preps;
+
+  public:
+  FusedPrepGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_)
+    : basegen::BaseGenerator(hp_, gg_, dp_)
+  {
+  }
+
+  private:
+  virtual void set_type() override final { type = "prepab"; }
+
+  virtual void set_usage() override final
+  {
+    u_a     = true;
+    u_b     = true;
+    u_c     = false;
+    u_w     = true;
+    u_alpha = false;
+    u_beta  = false;
+  }
+
+  virtual void setup_final() override final
+  {
+    for (auto emat_x : {Mat::E::A, Mat::E::B})
+    {
+      switch (hp.sus[emat_x].vs[Chi::E::WOS])
+      {
+      case Scratch::E::COPY:
+        preps[emat_x].reset(new copygen::CopyGenerator(emat_x, hp, gg, dp));
+        preps[emat_x]->setup();
+        break;
+      case Scratch::E::NFORM:
+        preps[emat_x] = nformgen::get_nform_generator(emat_x, hp, gg, dp);
+        break;
+      default: throw miog_error("the fused prep kernel requires WOS = COPY or NFORM for A and B");
+      }
+    }
+
+    if (preps[Mat::E::A]->get_prep_local_work_size() !=
+        preps[Mat::E::B]->get_prep_local_work_size())
+    {
+      throw miog_error("the prep kernels of A and B should have the same work group size, "
+                       "see set_should_be_hyperparams");
+    }
+
+    preps[Mat::E::B]->set_group_id_offset(preps[Mat::E::A]->get_prep_n_work_groups());
+  }
+
+  virtual size_t get_local_work_size() override final
+  {
+    return preps[Mat::E::A]->get_prep_local_work_size();
+  }
+
+  virtual size_t get_n_work_groups() override final
+  {
+    return preps[Mat::E::A]->get_prep_n_work_groups() +
+           preps[Mat::E::B]->get_prep_n_work_groups();
+  }
+
+  public:
+  virtual KType::E get_ktype() override final { return KType::E::WSAB; }
+
+  virtual KernBlob get_kernelstring() override final
+  {
+
+    std::stringstream ss;
+    ss << get_time_string();
+    ss << R"(
+/* ****************************************************
+* It prepares A and B in workspace, in one kernel. The
+* kernels of A and B are functions here, and the work
+* groups are partitioned between them
+****************************************************** */
+)";
+
+    ss << "#define TFLOAT " << dp.t_float << '\n'
+       << "#define N_GROUPS_PREP_A " << preps[Mat::E::A]->get_prep_n_work_groups() << '\n';
+
+    // the macros of A are undefined after its function, as B defines some of the same names
+    for (auto emat_x : {Mat::E::A, Mat::E::B})
+    {
+      std::stringstream ss_defs;
+      preps[emat_x]->append_definitions(ss_defs);
+      ss << "\n\n" << ss_defs.str() << "\n\n";
+      preps[emat_x]->append_function(ss);
+      if (emat_x == Mat::E::A)
+      {
+        for (auto& line : stringutil::split(ss_defs.str(), "\n"))
+        {
+          auto frags = stringutil::split(line);
+          if (frags.size() >= 2 && frags[0] == "#define" && frags[1] != "TFLOAT")
+          {
+            ss << "#undef " << frags[1] << '\n';
+          }
+        }
+      }
+    }
+
+    ss << "\n\n__attribute__((reqd_work_group_size(" << get_local_work_size() << ",1,1)))\n"
+       << "__kernel void " << kernelname;
+    append_fargs(ss);
+    ss << "{\nif (get_group_id(0) < N_GROUPS_PREP_A){\n";
+    preps[Mat::E::A]->append_call(ss);
+    ss << "\n}\nelse{\n";
+    preps[Mat::E::B]->append_call(ss);
+    ss << "\n}\n}\n";
+
+    return {get_ktype(),
+            {u_a, u_b, u_c, u_w, u_alpha, u_beta},
+            ss.str(),
+            kernelname,
+            get_n_work_groups() * get_local_work_size(),
+            get_local_work_size()};
+  }
+};
+
+KernBlob get_fused_prep_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+{
+  FusedPrepGenerator fpg(hp, gg, dp);
+  fpg.setup();
+  return fpg.get_kernelstring();
+}
+}
+}
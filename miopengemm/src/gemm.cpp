@@ -153,6 +153,210 @@ template GemmStatus xgemm<double>(bool,
                                   cl_event*,
                                   int ID);
 
+template <typename T>
+GemmStatus xgemm_chain(bool              isColMajor,
+                       bool              tA,
+                       bool              tB,
+                       size_t            m,
+                       size_t            n,
+                       size_t            k,
+                       T                 alpha,
+                       cl_mem            a,
+                       size_t            a_offset,
+                       size_t            lda,
+                       cl_mem            b,
+                       size_t            b_offset,
+                       size_t            ldb,
+                       T                 beta,
+                       cl_mem            c,
+                       size_t            c_offset,
+                       size_t            ldc,
+                       cl_mem            chain_table,
+                       cl_mem            chain_state,
+                       size_t            n_chain,
+                       cl_command_queue* ptr_queue,
+                       cl_uint           num_events_in_wait_list,
+                       const cl_event*   event_wait_list,
+                       cl_event*         ptr_event_user,
+                       int               ID)
+{
+
+  if (ID < 0)
+  {
+    ID = get_cacher().get_ID(isColMajor,
+                             tA,
+                             tB,
+                             false,
+                             m,
+                             n,
+                             k,
+                             lda,
+                             ldb,
+                             ldc,
+                             0,
+                             get_beta_type(beta),
+                             get_floattype_char<T>(),
+                             ptr_queue,
+                             true);
+  }
+
+  if (!get_cacher().chain_kernels[ID])
+  {
+    // the device has no chain kernel : the usual kernels are run once per problem, in order
+    std::vector<cl_ulong> table(3 * n_chain);
+    oclutil::cl_enqueue_read_buffer(*ptr_queue,
+                                    chain_table,
+                                    CL_TRUE,
+                                    0,
+                                    table.size() * sizeof(cl_ulong),
+                                    table.data(),
+                                    num_events_in_wait_list,
+                                    event_wait_list,
+                                    nullptr,
+                                    "xgemm_chain",
+                                    true);
+
+    cl_event previous = nullptr;
+    for (size_t chain_i = 0; chain_i < n_chain; ++chain_i)
+    {
+      cl_event done = nullptr;
+      xgemm<T>(isColMajor,
+               tA,
+               tB,
+               m,
+               n,
+               k,
+               alpha,
+               a,
+               a_offset + table[3 * chain_i + 0],
+               lda,
+               b,
+               b_offset + table[3 * chain_i + 1],
+               ldb,
+               beta,
+               c,
+               c_offset + table[3 * chain_i + 2],
+               ldc,
+               nullptr,
+               0,
+               0,
+               ptr_queue,
+               chain_i == 0 ? num_events_in_wait_list : 1,
+               chain_i == 0 ? event_wait_list : &previous,
+               chain_i + 1 == n_chain ? ptr_event_user : &done,
+               ID);
+      if (previous != nullptr)
+      {
+        oclutil::cl_release_event(previous, "xgemm_chain", true);
+      }
+      previous = done;
+    }
+    return {true, ID};
+  }
+
+  const Programs& programs = get_cacher().program_cache[ID];
+
+  std::array<cl_mem, Mem::E::N> gpu_mems;
+  std::array<size_t, Mem::E::N> offsets;
+
+  gpu_mems[Mem::E::A] = a;
+  gpu_mems[Mem::E::B] = b;
+  gpu_mems[Mem::E::C] = c;
+  gpu_mems[Mem::E::W] = nullptr;
+
+  offsets[Mem::E::A] = a_offset;
+  offsets[Mem::E::B] = b_offset;
+  offsets[Mem::E::C] = c_offset;
+  offsets[Mem::E::W] = 0;
+
+  // the chain arguments follow a, b, c, alpha and beta
+  cl_uint     n_chain_uint = static_cast<cl_uint>(n_chain);
+  AllKernArgs all_kern_args(0);
+  for (auto& index : programs.act_inds)
+  {
+    auto& program = programs.programs[index];
+    all_kern_args.emplace_back(
+      kerngen::get_arg_sizes_values(program.kblob, gpu_mems, offsets, sizeof(T), &alpha, &beta));
+    all_kern_args.back().emplace_back(sizeof(cl_mem), &chain_table);
+    all_kern_args.back().emplace_back(sizeof(cl_uint), &n_chain_uint);
+    all_kern_args.back().emplace_back(sizeof(cl_mem), &chain_state);
+  }
+
+  // the work groups count their completed problems in chain_state, from zero
+  cl_int               zero = 0;
+  oclutil::SafeClEvent zeroed("xgemm_chain");
+  oclutil::cl_enqueue_fill_buffer(*ptr_queue,
+                                  chain_state,
+                                  &zero,
+                                  sizeof(cl_int),
+                                  0,
+                                  n_chain * sizeof(cl_int),
+                                  num_events_in_wait_list,
+                                  event_wait_list,
+                                  &zeroed.clevent,
+                                  "xgemm_chain",
+                                  true);
+
+  KernelTimes* ktimes     = nullptr;
+  bool         debug_mode = false;
+  programs.run(
+    *ptr_queue, all_kern_args, 1, &zeroed.clevent, ktimes, ptr_event_user, debug_mode);
+
+  return {true, ID};
+}
+
+template GemmStatus xgemm_chain<float>(bool,
+                                       bool,
+                                       bool,
+                                       size_t,
+                                       size_t,
+                                       size_t,
+                                       float,
+                                       cl_mem,
+                                       size_t,
+                                       size_t,
+                                       cl_mem,
+                                       size_t,
+                                       size_t,
+                                       float,
+                                       cl_mem,
+                                       size_t,
+                                       size_t,
+                                       cl_mem,
+                                       cl_mem,
+                                       size_t,
+                                       cl_command_queue*,
+                                       cl_uint,
+                                       const cl_event*,
+                                       cl_event*,
+                                       int ID);
+
+template GemmStatus xgemm_chain<double>(bool,
+                                        bool,
+                                        bool,
+                                        size_t,
+                                        size_t,
+                                        size_t,
+                                        double,
+                                        cl_mem,
+                                        size_t,
+                                        size_t,
+                                        cl_mem,
+                                        size_t,
+                                        size_t,
+                                        double,
+                                        cl_mem,
+                                        size_t,
+                                        size_t,
+                                        cl_mem,
+                                        cl_mem,
+                                        size_t,
+                                        cl_command_queue*,
+                                        cl_uint,
+                                        const cl_event*,
+                                        cl_event*,
+                                        int ID);
+
 // TODO : beta = 1 optimisation. alpha = 0 optimisation. beta = 0 optimisation.
 template <typename T>
 GemmStatus gemm0(bool              isColMajor,
@@ -16,13 +16,20 @@
 namespace MIOpenGEMM
 {
 
+// PWG is packed in 10 bits
+const size_t max_n_pwg = 1023;
+
 RandomUtil& radutil17()
 {
   static RandomUtil x;
   return x;
 }
 
-std::vector<HyPas> Graph::get_neighbors(const HyPas& hp0, bool prioritize) const
+std::string get_graph_random_state() { return radutil17().get_state(); }
+
+void set_graph_random_state(const std::string& state) { radutil17().set_state(state); }
+
+std::vector<HyPas> Graph::get_neighbors(const HyPas& hp0, bool prioritize, bool cost_ordered) const
 {
 
   std::vector<int> uni_prios;
@@ -47,7 +54,21 @@ std::vector<HyPas> Graph::get_neighbors(const HyPas& hp0, bool prioritize) const
 
   std::vector<HyPas> neighbors;
 
-  if (prioritize == true)
+  if (cost_ordered == true)
+  {
+    std::vector<std::tuple<double, size_t>> predicted;
+    for (size_t zi = 0; zi < Z.size(); ++zi)
+    {
+      predicted.emplace_back(cost_model.get_time(std::get<0>(Z[zi]), geometry), zi);
+    }
+    std::sort(predicted.begin(), predicted.end());
+    for (auto& x : predicted)
+    {
+      neighbors.push_back(std::get<0>(Z[std::get<1>(x)]));
+    }
+  }
+
+  else if (prioritize == true)
   {
     for (auto& x : uni_prios)
     {
@@ -95,8 +116,11 @@ std::vector<std::tuple<HyPas, int>> Graph::get_p_coupled_away(const HyPas& hp0)
       for (auto& new_second_val : at(second_m).edges[second_p].at(second_value))
       {
 
-        // only if one increases and one decreases
-        if ((new_second_val > second_value) != (new_first_val > first_value))
+        // only if one increases and one decreases, except for GAL and PWG which change together,
+        // between STREAMK (PWG positive) and the others (PWG 0). Derivability filters the rest
+        bool is_gal_pwg = first_m == Mat::E::C && first_p == NonChi::E::GAL &&
+                          second_m == Mat::E::C && second_p == NonChi::E::PWG;
+        if (is_gal_pwg || (new_second_val > second_value) != (new_first_val > first_value))
         {
           HyPas hp1(hp0);
           hp1.sus[first_m].vs[first_p]   = new_first_val;
@@ -166,7 +190,7 @@ std::vector<std::tuple<HyPas, int>> Graph::get_mic_mac_transformed(const HyPas&
   return mmt;
 }
 
-bool has_no_effect(const HyPas& hp0, Mat::E emat_x, size_t i)
+bool has_no_effect(const HyPas& hp0, Mat::E emat_x, size_t i, size_t x)
 {
   // if GAL is not SUCOL, then NAW has no effect.
   if (hp0.sus.at(Mat::E::C).vs[NonChi::E::GAL] != GroupAllocation::E::SUCOL)
@@ -177,14 +201,55 @@ bool has_no_effect(const HyPas& hp0, Mat::E emat_x, size_t i)
     }
   }
 
-  // if ICE is 1, the IWI has no effect
+  // if GAL is not STREAMK, then PWG has no effect.
+  if (hp0.sus.at(Mat::E::C).vs[NonChi::E::GAL] != GroupAllocation::E::STREAMK)
+  {
+    if (emat_x == Mat::E::C && i == NonChi::E::PWG)
+    {
+      return true;
+    }
+  }
+
+  // if ICE is 1, the IWI and DSK have no effect
   if (hp0.sus.at(Mat::E::C).vs[NonChi::E::ICE] == 1)
   {
-    if (emat_x == Mat::E::C && i == NonChi::E::IWI)
+    if (emat_x == Mat::E::C && (i == NonChi::E::IWI || i == NonChi::E::DSK))
     {
       return true;
     }
   }
+
+  // Stream-K processes all tiles in its persistent work-groups, so IEK has no effect
+  if (hp0.sus.at(Mat::E::C).vs[NonChi::E::GAL] == GroupAllocation::E::STREAMK)
+  {
+    if (emat_x == Mat::E::C && i == NonChi::E::IEK)
+    {
+      return true;
+    }
+  }
+
+  // the skinny kernel (GMV) only uses MIC and VEW of A, and UNR, MAC, SKW, PUN, SZT and MAD
+  if (hp0.sus.at(Mat::E::C).vs[NonChi::E::GMV] == Binary::E::YES)
+  {
+    switch (emat_x)
+    {
+    case Mat::E::A: return i != Chi::E::MIC && i != Chi::E::VEW;
+    case Mat::E::B: return true;
+    case Mat::E::C:
+      return i != NonChi::E::UNR && i != NonChi::E::MAC && i != NonChi::E::SKW &&
+             i != NonChi::E::PUN && i != NonChi::E::SZT && i != NonChi::E::MAD &&
+             i != NonChi::E::GMV;
+    case Mat::E::N: break;
+    }
+  }
+
+  // LDS is read with width max(VEW, LRW), so changing LRW between values not above VEW has no
+  // effect
+  if (emat_x != Mat::E::C && i == Chi::E::LRW)
+  {
+    size_t vew = hp0.sus.at(emat_x).vs[Chi::E::VEW];
+    return hp0.sus.at(emat_x).vs[Chi::E::LRW] <= vew && x <= vew;
+  }
   return false;
 }
 
@@ -201,7 +266,7 @@ std::vector<std::tuple<HyPas, int>> Graph::get_one_aways(const HyPas& hp0) const
       for (auto& x : at(emat).edges.at(i).at(v0))
       {
         // has_no_effect : like NAW when GAL != 3.
-        if (!has_no_effect(hp0, emat, i))
+        if (!has_no_effect(hp0, emat, i, x))
         {
           HyPas hp1(hp0);
           hp1.sus[emat].vs[i] = x;
@@ -412,6 +477,7 @@ Graph::Graph(const Geometry&         gg,
     csubg(gg, cs.sub[Mat::E::C], devinfo),
     geometry(gg),
     devinfo(di),
+    cost_model(di),
     constraints(cs),
     mowri(mowri_)
 {
@@ -422,6 +488,7 @@ Graph::Graph(const Geometry&         gg,
   p_coupled.push_back({{Mat::E::A, Chi::E::MIC}, {Mat::E::B, Chi::E::MIC}});
   p_coupled.push_back({{Mat::E::C, NonChi::E::UFO}, {Mat::E::C, NonChi::E::PUN}});
   p_coupled.push_back({{Mat::E::C, NonChi::E::UNR}, {Mat::E::C, NonChi::E::ICE}});
+  p_coupled.push_back({{Mat::E::C, NonChi::E::GAL}, {Mat::E::C, NonChi::E::PWG}});
 }
 
 bool Graph::contains(Mat::E emat, size_t hpi, size_t value) const
@@ -508,8 +575,10 @@ void ChiSuGr::initialise_edges()
   edges[Chi::E::PLU] = {g_binary()};
   edges[Chi::E::LIW] = {g_binary()};
   edges[Chi::E::MIW] = {g_binary()};
+  edges[Chi::E::PRF] = {g_binary()};
 
   edges[Chi::E::VEW] = {{1, {2}}, {2, {1, 4}}, {4, {2, 1}}};
+  edges[Chi::E::LRW] = {{1, {2}}, {2, {1, 4}}, {4, {2, 1}}};
 
   edges[Chi::E::WOS] = {{Scratch::E::UNUSED, {Scratch::E::COPY, Scratch::E::NFORM}},
                         {Scratch::E::COPY, {Scratch::E::UNUSED, Scratch::E::NFORM}},
@@ -530,9 +599,39 @@ void CSuGr::initialise_edges()
 
   edges[NonChi::E::NAW] = {{64, {16}}, {16, {64}}};
   edges[NonChi::E::GAL] = {
-    {GroupAllocation::E::BYROW, {GroupAllocation::E::BYCOL, GroupAllocation::E::SUCOL}},
-    {GroupAllocation::E::BYCOL, {GroupAllocation::E::BYROW, GroupAllocation::E::SUCOL}},
-    {GroupAllocation::E::SUCOL, {GroupAllocation::E::BYROW, GroupAllocation::E::BYCOL}}};
+    {GroupAllocation::E::BYROW,
+     {GroupAllocation::E::BYCOL, GroupAllocation::E::SUCOL, GroupAllocation::E::STREAMK}},
+    {GroupAllocation::E::BYCOL,
+     {GroupAllocation::E::BYROW, GroupAllocation::E::SUCOL, GroupAllocation::E::STREAMK}},
+    {GroupAllocation::E::SUCOL,
+     {GroupAllocation::E::BYROW, GroupAllocation::E::BYCOL, GroupAllocation::E::STREAMK}},
+    {GroupAllocation::E::STREAMK, {GroupAllocation::E::BYROW, GroupAllocation::E::BYCOL}}};
+
+  // persistent work-groups, 1, 2, 3 or 4 per compute unit. 0 is for GAL other than STREAMK,
+  // reached with the coupled move from STREAMK
+  std::vector<size_t> pwgs;
+  for (size_t per_cu = 1; per_cu <= 4; ++per_cu)
+  {
+    size_t pwg = std::min<size_t>(
+      per_cu * std::max<size_t>(1, ptr_devinfo->device_max_compute_units), max_n_pwg);
+    if (pwgs.size() == 0 || pwgs.back() != pwg)
+    {
+      pwgs.push_back(pwg);
+    }
+  }
+  edges[NonChi::E::PWG] = {{0, {pwgs[0]}}};
+  for (size_t i = 0; i < pwgs.size(); ++i)
+  {
+    edges[NonChi::E::PWG][pwgs[i]] = {0};
+    if (i > 0)
+    {
+      edges[NonChi::E::PWG][pwgs[i]].push_back(pwgs[i - 1]);
+    }
+    if (i + 1 < pwgs.size())
+    {
+      edges[NonChi::E::PWG][pwgs[i]].push_back(pwgs[i + 1]);
+    }
+  }
 
   if (ptr_devinfo->wg_atom_size != 64 && ptr_devinfo->wg_atom_size != 32)
   {
@@ -590,6 +689,19 @@ void CSuGr::initialise_edges()
   edges[NonChi::E::MIA] = {g_binary()};
   edges[NonChi::E::SZT] = {g_binary()};
   edges[NonChi::E::MAD] = {g_binary()};
+  edges[NonChi::E::DBL] = {g_binary()};
+  edges[NonChi::E::DSK] = {g_binary()};
+  edges[NonChi::E::IEK] = {g_binary()};
+
+  // the skinny kernel is only for small n
+  if (ptr_gg->n <= max_n_skinny)
+  {
+    edges[NonChi::E::GMV] = {g_binary()};
+  }
+  else
+  {
+    edges[NonChi::E::GMV] = {{Binary::E::NO, {}}};
+  }
 }
 
 void ChiSuGr::refine_start_range()
@@ -609,6 +721,12 @@ void ChiSuGr::refine_start_range()
 
   start_range[Chi::E::VEW] = {1};
 
+  // like DBL, prefetching hides global latency over many unrolls
+  if (ptr_gg->k < 1024)
+  {
+    start_range[Chi::E::PRF] = {Binary::E::NO};
+  }
+
   set_start_mic();
 }
 
@@ -619,6 +737,34 @@ void CSuGr::refine_start_range()
   start_range[NonChi::E::UFO] = {Binary::E::NO};
   start_range[NonChi::E::SZT] = {Binary::E::NO};
 
+  // double buffering LDS hides global latency over many unrolls, so only for large k
+  if (ptr_gg->k < 1024)
+  {
+    start_range[NonChi::E::DBL] = {Binary::E::NO};
+  }
+
+  // the partial tiles of a deterministic split in k, and of Stream-K, live in workspace
+  if (ptr_gg->wSpaceSize == 0)
+  {
+    start_range[NonChi::E::DSK] = {Binary::E::NO};
+    start_range[NonChi::E::GAL] = {
+      GroupAllocation::E::BYROW, GroupAllocation::E::BYCOL, GroupAllocation::E::SUCOL};
+  }
+
+  // PWG is 0 off STREAMK. Moves to (and from) STREAMK are coupled with PWG, see p_coupled.
+  // If the constraints put GAL on STREAMK, it has persistent work-groups from the start
+  if (ptr_constraint->range[NonChi::E::GAL] == GroupAllocation::E::STREAMK ||
+      ptr_constraint->start_range[NonChi::E::GAL] == GroupAllocation::E::STREAMK)
+  {
+    start_range[NonChi::E::PWG].erase(
+      std::remove(start_range[NonChi::E::PWG].begin(), start_range[NonChi::E::PWG].end(), 0),
+      start_range[NonChi::E::PWG].end());
+  }
+  else
+  {
+    start_range[NonChi::E::PWG] = {0};
+  }
+
   if ((ptr_gg->m) > 200 && (ptr_gg->n) > 200)
   {
     if (ptr_devinfo->wg_atom_size == 32)
@@ -341,6 +341,12 @@ std::vector<size_t> get_hy_v(std::string hy_s, bool hy_s_full, Mat::E emat)
   {
     for (size_t hpi = 0; hpi < p_kv->N; ++hpi)
     {
+      // strings written before a hyper-parameter was added
+      if (hy_v[hpi] == Status::E::UNDEFINED)
+      {
+        hy_v[hpi] = (*Mat::mat_to_omitted(emat))[hpi];
+      }
+
       if (hy_v[hpi] == Status::E::UNDEFINED)
       {
         std::stringstream ss;
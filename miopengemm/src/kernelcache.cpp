@@ -3,11 +3,14 @@
  *******************************************************************************/
 #include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <miopengemm/enums.hpp>
 #include <miopengemm/kernelcache.hpp>
 #include <miopengemm/redirection.hpp>
+#include <miopengemm/timer.hpp>
 
 namespace MIOpenGEMM
 {
@@ -74,21 +77,153 @@ std::string CacheKey::get_string() const
   return ss.str();
 }
 
-KernelCache init_kernel_cache()
+namespace
 {
+
+// the entries in the .cachetxt files are parsed with these, so that
+// CacheKeys and HyPas are only constructed for entries which pass the filter.
+class RawCacheKey
+{
+  public:
+  std::string dvc;
+  std::string constraints;
+  std::string gg;
+};
+
+class RawHyPas
+{
+  public:
+  std::array<std::string, Mat::E::N> sus;
+};
+
+class ShardLoader
+{
+  private:
+  // empty for all devices
+  std::string device;
+  // 0 for all float types
+  char        floattype;
+  std::string float_suffix;
+
+  public:
   KernelCache kc;
 
+  ShardLoader(const std::string& device_, char floattype_)
+    : device(device_), floattype(floattype_)
+  {
+    if (floattype != 0)
+    {
+      float_suffix = "_f" + std::to_string(8 * (floattype == 'd' ? sizeof(double) : sizeof(float)));
+    }
+  }
+
+  void add(const RawCacheKey& rck, const RawHyPas& rhp)
+  {
+    if (!device.empty() && rck.dvc != device)
+    {
+      return;
+    }
+
+    if (floattype != 0 && (rck.gg.size() < float_suffix.size() ||
+                           rck.gg.compare(rck.gg.size() - float_suffix.size(),
+                                          float_suffix.size(),
+                                          float_suffix) != 0))
+    {
+      return;
+    }
+
+    kc.add(CacheKey(rck.dvc, Constraints(rck.constraints), Geometry(rck.gg)), HyPas(rhp.sus));
+  }
+};
+
+KernelCacheShardStats init_kernel_cache(const std::string& device, char floattype, KernelCache& out)
+{
+  Timer timer;
+  timer.start();
+
+  ShardLoader kc(device, floattype);
+
 #include "cache1.cachetxt"
 #include "cache2.cachetxt"
 #include "cache3.cachetxt"
 #include "cache4.cachetxt"
-  return kc;
+
+  out = std::move(kc.kc);
+  return {device, floattype, out.get_size(), out.get_memory_estimate(), timer.get_elapsed()};
 }
 
-const KernelCache& get_kernel_cache()
+class ShardRegistry
+{
+  public:
+  std::mutex mut;
+  // keyed on device + floattype. The full cache has key "" + 0.
+  std::map<std::string, std::unique_ptr<KernelCache>> shards;
+  std::vector<KernelCacheShardStats> stats;
+};
+
+ShardRegistry& get_shard_registry()
 {
-  static const KernelCache kc = init_kernel_cache();
-  return kc;
+  static ShardRegistry registry;
+  return registry;
+}
+}
+
+const KernelCache& get_kernel_cache(const std::string& device, char floattype)
+{
+  auto&                       registry = get_shard_registry();
+  std::lock_guard<std::mutex> lock(registry.mut);
+
+  std::string key = device + '_' + std::string(1, floattype);
+  auto        it  = registry.shards.find(key);
+  if (it == registry.shards.end())
+  {
+    std::unique_ptr<KernelCache> up_kc(new KernelCache);
+    registry.stats.push_back(init_kernel_cache(device, floattype, *up_kc));
+    it = registry.shards.emplace(key, std::move(up_kc)).first;
+  }
+  return *(it->second);
+}
+
+const KernelCache& get_kernel_cache() { return get_kernel_cache("", 0); }
+
+std::vector<KernelCacheShardStats> get_kernel_cache_shard_stats()
+{
+  auto&                       registry = get_shard_registry();
+  std::lock_guard<std::mutex> lock(registry.mut);
+  return registry.stats;
+}
+
+std::string KernelCacheShardStats::get_string() const
+{
+  std::stringstream ss;
+  ss << "kernel cache shard  device : `" << (device.empty() ? "(all)" : device)
+     << "'  floattype : `" << (floattype == 0 ? std::string("(all)") : std::string(1, floattype))
+     << "'  entries : " << n_entries << "  memory : " << n_bytes / 1024 << " [KB]"
+     << "  load time : " << load_time << " [s]";
+  return ss.str();
+}
+
+size_t KernelCache::get_memory_estimate() const
+{
+  size_t n_bytes = vals.bucket_count() * sizeof(void*);
+  for (auto& x : vals)
+  {
+    auto& ck = x.first;
+    auto& hp = x.second;
+    // node : key, value and next pointer
+    n_bytes += sizeof(x) + sizeof(void*);
+    n_bytes += ck.dvc.capacity() + ck.concatenated.capacity();
+    n_bytes += ck.gg.tX.capacity() / 8 + ck.gg.ldX.capacity() * sizeof(size_t);
+    for (auto& c : ck.constraints.sub)
+    {
+      n_bytes += (c.range.capacity() + c.start_range.capacity()) * sizeof(size_t);
+    }
+    for (auto& su : hp.sus)
+    {
+      n_bytes += su.vs.capacity() * sizeof(size_t);
+    }
+  }
+  return n_bytes;
 }
 
 HyPas KernelCache::at(const CacheKey& ckey, bool swap_ab) const
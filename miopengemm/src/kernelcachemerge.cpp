@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <miopengemm/kernelcachemerge.hpp>
 #include <miopengemm/setabcw.hpp>
+#include <miopengemm/timingstats.hpp>
 #include <miopengemm/tinytwo.hpp>
 
 namespace MIOpenGEMM
@@ -18,21 +19,6 @@ namespace canonical
 const bool noswap = false;
 }
 
-// sequence for a fair penalty shoot-out.
-std::vector<bool> get_thue_morse(size_t length)
-{
-  std::vector<bool> thue_morse{true, false};
-  while (thue_morse.size() < length)
-  {
-    for (auto x : thue_morse)
-    {
-      thue_morse.push_back(!x);
-    }
-  }
-  thue_morse.resize(length);
-  return thue_morse;
-}
-
 template <typename TFl>
 void populate(const std::vector<CacheKey>& cache_keys,
               const KernelCache&           kc1,
@@ -104,7 +90,7 @@ void populate(const std::vector<CacheKey>& cache_keys,
       times.push_back(zoo);
     };
 
-    for (auto kc1_first : get_thue_morse(14))
+    for (auto kc1_first : timingstats::get_thue_morse(14))
     {
       if (kc1_first)
       {
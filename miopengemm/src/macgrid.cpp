@@ -36,14 +36,23 @@ void Grid::good_initialise(size_t gA, size_t gB)
   error_message = "";
 }
 
-Grid::Grid(size_t mac, size_t skew)  // 32, 9
+namespace
+{
+enum class GridStatus
 {
+  GOOD,
+  NON_INT,
+  ZERO_LENGTH,
+  BAD_PRODUCT
+};
 
+GridStatus set_lengths(size_t mac, size_t skew, double& na, double& nb, size_t& u_na, size_t& u_nb)
+{
   double dbl_lg2_mac = std::log2(static_cast<double>(mac));  // 5
   size_t lg2_mac     = static_cast<size_t>(dbl_lg2_mac);     // 5
 
-  double na = std::exp2(lg2_mac / 2 + lg2_mac % 2);  // 8
-  double nb = static_cast<double>(mac) / na;         // 4
+  na = std::exp2(lg2_mac / 2 + lg2_mac % 2);  // 8
+  nb = static_cast<double>(mac) / na;         // 4
   for (size_t i = skew0; i < skew; ++i)
   {
     na /= 2.;
@@ -56,30 +65,59 @@ Grid::Grid(size_t mac, size_t skew)  // 32, 9
     nb /= 2.;
   }
 
-  size_t u_na = static_cast<size_t>(na);
-  size_t u_nb = static_cast<size_t>(nb);
+  u_na = static_cast<size_t>(na);
+  u_nb = static_cast<size_t>(nb);
   if (std::abs(na * nb - static_cast<double>(u_na * u_nb)) > 1e-7)
   {
-    std::stringstream errm_ss;
-    errm_ss << "Casting non-ints. ";
-    errm_ss << "na: " << na << " nb:" << nb << " u_na:" << u_na << " u_nb:" << u_nb << '.';
-    bad_initialise(errm_ss.str());
-    return;
+    return GridStatus::NON_INT;
   }
 
   if (u_na < 1 || u_nb < 1)
   {
-    bad_initialise("One of the lengths is zero. Maybe skewness requested is too extreme.");
-    return;
+    return GridStatus::ZERO_LENGTH;
   }
 
   if (u_na * u_nb != mac)
   {
+    return GridStatus::BAD_PRODUCT;
+  }
+
+  return GridStatus::GOOD;
+}
+}
+
+bool get_grid(size_t mac, size_t skew, size_t& grid_A, size_t& grid_B)
+{
+  double na;
+  double nb;
+  return set_lengths(mac, skew, na, nb, grid_A, grid_B) == GridStatus::GOOD;
+}
+
+Grid::Grid(size_t mac, size_t skew)  // 32, 9
+{
+  double na;
+  double nb;
+  size_t u_na;
+  size_t u_nb;
+
+  switch (set_lengths(mac, skew, na, nb, u_na, u_nb))
+  {
+  case GridStatus::NON_INT:
+  {
+    std::stringstream errm_ss;
+    errm_ss << "Casting non-ints. ";
+    errm_ss << "na: " << na << " nb:" << nb << " u_na:" << u_na << " u_nb:" << u_nb << '.';
+    bad_initialise(errm_ss.str());
+    return;
+  }
+  case GridStatus::ZERO_LENGTH:
+    bad_initialise("One of the lengths is zero. Maybe skewness requested is too extreme.");
+    return;
+  case GridStatus::BAD_PRODUCT:
     bad_initialise("The product of the computed edge lengths is not MAC.");
     return;
+  case GridStatus::GOOD: good_initialise(u_na, u_nb); return;
   }
-
-  good_initialise(u_na, u_nb);
 }
 
 size_t Grid::at(Mat::E emat)
@@ -14,12 +14,43 @@
 namespace MIOpenGEMM
 {
 
+namespace
+{
+// the skinny kernel (GMV), with the constraints applied. VEW 4 divides both MIC and UNR, so A
+// is loaded in vectors whichever of its dimensions is contiguous
+HyPas get_generic_skinny(const Constraints& constraints)
+{
+  HyPas hp = {{{"MIC4_PAD0_PLU0_LIW0_MIW0_WOS0_VEW4",
+                "MIC1_PAD0_PLU0_LIW0_MIW0_WOS0_VEW1",
+                "UNR8_GAL1_PUN1_ICE1_IWI0_SZT0_NAW64_UFO0_MAC256_SKW10_AFI0_MIA0_MAD0_GMV1"}}};
+  hp.replace_where_defined(constraints);
+  return hp;
+}
+
+// for skinny problems, the largest distance (Geometry::get_distance) to a cache entry which
+// is preferred to the generic skinny kernel : n (or m) differing by a factor of about 1.4, or k
+// by a factor of 2. Entries further away are mostly of tiled kernels for larger n
+const double skinny_cache_threshold = 1.0;
+}
+
+bool is_skinny(const Geometry& gg, const Constraints& constraints)
+{
+  auto hp = get_generic_skinny(constraints);
+  return gg.n <= max_n_skinny && hp.sus[Mat::E::C].vs[NonChi::E::GMV] == Binary::E::YES &&
+         is_dvble(hp, gg);
+}
+
 HyPas get_generic(const Geometry& gg, const Constraints& constraints)
 {
 
   HyPas hp;
 
-  if (gg.m >= 1000 && gg.n >= 1000)
+  if (is_skinny(gg, constraints))
+  {
+    hp = get_generic_skinny(constraints);
+  }
+
+  else if (gg.m >= 1000 && gg.n >= 1000)
   {
     hp = {{{"MIC5_PAD2_PLU0_LIW1_MIW1_WOS0_VEW1",
             "MIC4_PAD2_PLU0_LIW0_MIW1_WOS0_VEW1",
@@ -64,7 +95,13 @@ Solution get_default_soln(const oclutil::DevInfo& devinfo,
   double extime = 0;
   HyPas  hp;
 
-  auto&& kernel_cache = get_kernel_cache();
+  // entries for other devices are only considered if there are none for this device.
+  const KernelCache* ptr_kernel_cache = &get_kernel_cache(devinfo.identifier, gg.floattype);
+  if (ptr_kernel_cache->get_size() == 0)
+  {
+    ptr_kernel_cache = &get_kernel_cache();
+  }
+  auto&& kernel_cache = *ptr_kernel_cache;
 
   Timer timer;
   timer.start();
@@ -75,9 +112,30 @@ Solution get_default_soln(const oclutil::DevInfo& devinfo,
   bool   catch_ROCm_small_k = false;
   size_t ROCm_small_k       = 1;
 
+  // for skinny problems, only a nearby cache entry is preferred to the skinny kernel (find
+  // benchmarks the two, see TinyZero::single_descent_find)
+  bool   skinny          = is_skinny(gg, constraints);
+  double cache_threshold =
+    skinny ? skinny_cache_threshold : 0.1 * std::numeric_limits<double>::max();
+
+  // interpolation between cache entries only makes sense for the best (rank 0) default.
+  nearest::Interpolated interpolated("rank is not 0, interpolation not attempted");
+  if (rank == 0 && !skinny)
+  {
+    interpolated = nearest::get_interpolated(ck, graph, kernel_cache);
+  }
+
+  if (interpolated.is_interpolated)
+  {
+    bool is_not_canonical = redirection::get_is_not_canonical(gg);
+    hp                    = interpolated.hp.get_reflected(is_not_canonical);
+
+    mowri << "Interpolated from kernel cache, " << interpolated.msg << Flush;
+  }
+
   // TODO : check this.
-  if ((catch_ROCm_small_k == false || gg.k > ROCm_small_k) &&
-      (nearest::is_within(ck, graph, kernel_cache, 0.1 * std::numeric_limits<double>::max(), rank)))
+  else if ((catch_ROCm_small_k == false || gg.k > ROCm_small_k) &&
+           (nearest::is_within(ck, graph, kernel_cache, cache_threshold, rank)))
   {
     auto nearest_ck       = nearest::get(ck, graph, kernel_cache, rank);
     bool is_not_canonical = redirection::get_is_not_canonical(gg);
@@ -122,8 +180,28 @@ Solution find(float            allotted_time,
   bool   c_is_const    = true;
   cl_mem workspace_gpu = nullptr;
 
-  Ver::E         e_ver              = verbose ? Ver::E::TERMINAL : Ver::E::SILENT;
-  std::string    constraints_string = enforce_determinism ? "C__ICE1" : "";
+  // workspace for benchmarking, the Solution's kernels use tgg.wSpaceSize of it
+  oclutil::SafeClMem workspace_safemem("workspace of find");
+  if (tgg.wSpaceSize > 0)
+  {
+    oclutil::cl_set_buffer_from_command_queue(workspace_safemem.clmem,
+                                              command_queue,
+                                              CL_MEM_READ_WRITE,
+                                              tgg.wSpaceSize * tgg.derived.float_size_bytes,
+                                              NULL,
+                                              "allocating workspace of find",
+                                              true);
+    workspace_gpu = workspace_safemem.clmem;
+  }
+
+  // splits in k are deterministic if reduced in workspace (DSK), otherwise they are excluded
+  std::string constraints_string = "";
+  if (enforce_determinism)
+  {
+    constraints_string = tgg.wSpaceSize > 0 ? "C_DSK1" : "C_ICE1";
+  }
+
+  Ver::E         e_ver = verbose ? Ver::E::TERMINAL : Ver::E::SILENT;
   Constraints    constraints(constraints_string);
   auto           find_params = get_at_least_n_seconds(static_cast<double>(allotted_time));
   owrite::Writer mowri(e_ver, "");
@@ -3,6 +3,8 @@
  *******************************************************************************/
 
 #include <algorithm>
+#include <cmath>
+#include <sstream>
 #include <miopengemm/nearest.hpp>
 
 namespace MIOpenGEMM
@@ -17,7 +19,7 @@ bool is_within(
   for (auto& key : kc.get_keys())
   {
     if (graph.contains(kc.at(key)) && key.get_distance(ck) < threshold &&
-        Derivabilty(kc.at(key), ck.gg).is_derivable)
+        is_dvble(kc.at(key), ck.gg))
     {
       ++count;
       if (count > rank)
@@ -51,7 +53,7 @@ CacheKey get(const CacheKey& ck, const Graph& graph, const KernelCache& kc, size
     auto key      = cache_keys[keyi];
     auto distance = ck.get_distance(key);
     auto hp       = kc.at(key);
-    if (graph.contains(kc.at(key)) && Derivabilty(hp, ck.gg).is_derivable)
+    if (graph.contains(kc.at(key)) && is_dvble(hp, ck.gg))
     {
       v_di.emplace_back(std::make_tuple(distance, keyi));
     }
@@ -78,5 +80,225 @@ CacheKey get(const CacheKey& ck, const Graph& graph, const KernelCache& kc, size
 
   return nearest_derivable;
 }
+
+namespace
+{
+
+// the dimensions along which cache entries are interpolated.
+enum class Dim
+{
+  M = 0,
+  N,
+  K
+};
+
+size_t get_dim(const Geometry& gg, Dim d)
+{
+  switch (d)
+  {
+  case Dim::M: return gg.m;
+  case Dim::N: return gg.n;
+  case Dim::K: return gg.k;
+  }
+  throw miog_error("unrecognised Dim in get_dim");
+}
+
+// are gg0 and gg1 the same, except possibly in dimension d? The ldX may differ only through d,
+// that is, the paddings (ldX - coalesced dimension) and the alignments of the ldX must agree.
+bool is_same_off_dim(const Geometry& gg0, const Geometry& gg1, Dim d)
+{
+  if (!gg0.same_transposes(gg1) || gg0.floattype != gg1.floattype ||
+      gg0.wSpaceSize != gg1.wSpaceSize)
+  {
+    return false;
+  }
+  for (auto d_other : {Dim::M, Dim::N, Dim::K})
+  {
+    if (d_other != d && get_dim(gg0, d_other) != get_dim(gg1, d_other))
+    {
+      return false;
+    }
+  }
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    if (gg0.ldX[emat] - gg0.get_coal(emat) != gg1.ldX[emat] - gg1.get_coal(emat))
+    {
+      return false;
+    }
+    for (size_t x : {2, 4, 8})
+    {
+      if ((gg0.ldX[emat] % x == 0) != (gg1.ldX[emat] % x == 0))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// is there a cache entry so close to ck (the same m, n and k, or within near_distance) that
+// it should be used as is, rather than interpolated past?
+bool has_near_entry(const CacheKey& ck, const Graph& graph, const KernelCache& kc)
+{
+  double near_distance = 0.05;
+  if (!is_within(ck, graph, kc, std::numeric_limits<double>::max(), 0))
+  {
+    return false;
+  }
+  auto ck_near = get(ck, graph, kc, 0);
+  return (ck_near.gg.m == ck.gg.m && ck_near.gg.n == ck.gg.n && ck_near.gg.k == ck.gg.k) ||
+         ck.get_distance(ck_near) < near_distance;
+}
+
+// hyper-parameters whose values are ordered sizes, for which interpolating makes sense.
+// the remaining hyper-parameters are categorical, the nearer bracket's value is used for them.
+bool is_interpolatable(Mat::E emat, size_t hpi)
+{
+  if (emat == Mat::E::C)
+  {
+    return hpi == NonChi::E::UNR || hpi == NonChi::E::NAW || hpi == NonChi::E::MAC ||
+           hpi == NonChi::E::ICE;
+  }
+  return hpi == Chi::E::MIC;
+}
+}
+
+Interpolated get_interpolated(const CacheKey& ck, const Graph& graph, const KernelCache& kc)
+{
+
+  if (kc.check_for(ck).is_present)
+  {
+    return {"exact cache match exists, nothing to interpolate"};
+  }
+
+  if (has_near_entry(ck, graph, kc))
+  {
+    return {"a near cache match exists, nothing to interpolate"};
+  }
+
+  auto cache_keys = kc.get_keys();
+
+  // the tightest bracketing pair (in log space), over all the dimensions
+  bool   found      = false;
+  size_t i_lower    = 0;
+  size_t i_upper    = 0;
+  double log_span   = std::numeric_limits<double>::max();
+  Dim    d_selected = Dim::K;
+
+  for (auto d : {Dim::M, Dim::N, Dim::K})
+  {
+    size_t v_in      = get_dim(ck.gg, d);
+    bool   has_lower = false;
+    bool   has_upper = false;
+    size_t il        = 0;
+    size_t iu        = 0;
+
+    for (size_t keyi = 0; keyi < cache_keys.size(); ++keyi)
+    {
+      auto& key = cache_keys[keyi];
+      if (key.dvc != ck.dvc || key.constraints.get_string() != ck.constraints.get_string() ||
+          !is_same_off_dim(key.gg, ck.gg, d) || !graph.contains(kc.at(key)))
+      {
+        continue;
+      }
+
+      size_t v_key = get_dim(key.gg, d);
+      if (v_key < v_in && (!has_lower || v_key > get_dim(cache_keys[il].gg, d)))
+      {
+        has_lower = true;
+        il        = keyi;
+      }
+      else if (v_key > v_in && (!has_upper || v_key < get_dim(cache_keys[iu].gg, d)))
+      {
+        has_upper = true;
+        iu        = keyi;
+      }
+    }
+
+    if (has_lower && has_upper)
+    {
+      double span = std::log(static_cast<double>(get_dim(cache_keys[iu].gg, d))) -
+                    std::log(static_cast<double>(get_dim(cache_keys[il].gg, d)));
+      if (span < log_span)
+      {
+        found      = true;
+        log_span   = span;
+        i_lower    = il;
+        i_upper    = iu;
+        d_selected = d;
+      }
+    }
+  }
+
+  if (!found)
+  {
+    return {"no pair of cache entries brackets the geometry along m, n or k"};
+  }
+
+  const CacheKey& ck_lower = cache_keys[i_lower];
+  const CacheKey& ck_upper = cache_keys[i_upper];
+  const HyPas&    hp_lower = kc.at(ck_lower);
+  const HyPas&    hp_upper = kc.at(ck_upper);
+
+  // relative position of ck between the brackets, in log space : 0 at lower, 1 at upper.
+  double t = (std::log(static_cast<double>(get_dim(ck.gg, d_selected))) -
+              std::log(static_cast<double>(get_dim(ck_lower.gg, d_selected)))) /
+             log_span;
+
+  const HyPas& hp_near = t < 0.5 ? hp_lower : hp_upper;
+  const HyPas& hp_far  = t < 0.5 ? hp_upper : hp_lower;
+
+  HyPas hp = hp_near;
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    for (size_t hpi = 0; hpi < Mat::mat_to_xchi(emat)->N; ++hpi)
+    {
+      size_t v_lower = hp_lower.sus[emat].vs[hpi];
+      size_t v_upper = hp_upper.sus[emat].vs[hpi];
+      if (v_lower == v_upper || !is_interpolatable(emat, hpi))
+      {
+        continue;
+      }
+
+      double log_target = (1 - t) * std::log(static_cast<double>(v_lower)) +
+                          t * std::log(static_cast<double>(v_upper));
+
+      // the value in graph, in the closed interval spanned by the brackets, closest to target.
+      size_t v_min  = std::min(v_lower, v_upper);
+      size_t v_max  = std::max(v_lower, v_upper);
+      size_t v_best = hp_near.sus[emat].vs[hpi];
+      double d_best = std::abs(std::log(static_cast<double>(v_best)) - log_target);
+      for (size_t v = v_min; v <= v_max; ++v)
+      {
+        double d_v = std::abs(std::log(static_cast<double>(v)) - log_target);
+        if (d_v < d_best && graph.contains(emat, hpi, v))
+        {
+          v_best = v;
+          d_best = d_v;
+        }
+      }
+
+      HyPas hp_candidate             = hp;
+      hp_candidate.sus[emat].vs[hpi] = v_best;
+      if (is_dvble(hp_candidate, ck.gg))
+      {
+        hp = hp_candidate;
+      }
+    }
+  }
+
+  std::stringstream ss;
+  ss << "interpolated (t = " << t << ") between\n"
+     << ck_lower.get_string() << "and\n"
+     << ck_upper.get_string();
+
+  // if no value was interpolated, hp is a bracket's, which nearest returns just as well
+  if (hp == hp_near || hp == hp_far || !graph.contains(hp) || !is_dvble(hp, ck.gg))
+  {
+    return {"no hyper-parameter was interpolated between the bracketing cache entries"};
+  }
+
+  return {hp, ss.str()};
+}
 }
 }
@@ -1,6 +1,7 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
+#include <memory>
 #include <sstream>
 #include <string>
 #include <miopengemm/error.hpp>
@@ -40,10 +41,8 @@ class NormalFormGenerator : public prepgen::PrepGenerator
        << "[mu_pll_i*READ_STRIDE_PLL_K + mu_perp_i*READ_STRIDE_PERP_K];";
   }
 
-  KernBlob get_kernelstring() override final
+  virtual void append_definitions(std::stringstream& ss) override final
   {
-    std::stringstream ss;
-
     ss << "#define TFLOAT " << dp.t_float << '\n'
        << "#define TINT" << Mem::M().name[emat_x] << " " << dp.tints[emat_x] << '\n'
        << "#define N_WORK_ITEMS_PER_GROUP " << dp.at(emat_x).cw2_local_work_size << '\n'
@@ -77,15 +76,13 @@ class NormalFormGenerator : public prepgen::PrepGenerator
     final_unroll_depth =
       (final_unroll_depth == 0 ? hp.sus[Mat::E::C].vs[NonChi::E::UNR] : final_unroll_depth);
 
-    ss << "\n#define FINAL_UNROLL_DEPTH " << final_unroll_depth << "\n\n\n"
-       << "__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))" << '\n'
-       << "__kernel void " << kernelname;
-
-    append_fargs(ss);
+    ss << "\n#define FINAL_UNROLL_DEPTH " << final_unroll_depth << '\n';
+  }
 
-    ss << "{"
-       << "\n/* setting up where this thread works */\n"
-       << "TINT" << Mem::M().name[emat_x] << " group_id = get_group_id(0);\n"
+  virtual void append_body(std::stringstream& ss) override final
+  {
+    ss << "\n/* setting up where this thread works */\n"
+       << "TINT" << Mem::M().name[emat_x] << " group_id = " << get_group_id_string() << ";\n"
        << "TINT" << Mem::M().name[emat_x] << " micro_id = (TINT" << Mem::M().name[emat_x]
        << ")(get_local_id(0));\n"
        << "\n"
@@ -149,15 +146,6 @@ for (ushort mu_perp_i = 0; mu_perp_i < MICRO_TILE_PERP_UNROLL; ++mu_perp_i) {
 }
 
 )";
-
-    ss << "\n}\n";
-
-    return {get_ktype(),
-            {u_a, u_b, u_c, u_w, u_alpha, u_beta},
-            ss.str(),
-            kernelname,
-            get_global_work_size(),
-            get_local_work_size()};
   }
 
   virtual void setup_final() override final {}
@@ -182,5 +170,13 @@ get_nform_kernelstring(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const
   nfg.setup();
   return nfg.get_kernelstring();
 }
+
+std::unique_ptr<prepgen::PrepGenerator>
+get_nform_generator(Mat::E emat_x, const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+{
+  std::unique_ptr<prepgen::PrepGenerator> nfg(new NormalFormGenerator(emat_x, hp, gg, dp));
+  nfg->setup();
+  return nfg;
+}
 }
 }
@@ -288,6 +288,30 @@ Result cl_enqueue_copy_buffer(cl_command_queue   command_queue,
   return confirm_cl_status(ret, hash, "cl_enqueue_copy_buffer", strict);
 }
 
+Result cl_enqueue_fill_buffer(cl_command_queue   command_queue,
+                              cl_mem             buffer,
+                              const void*        pattern,
+                              size_t             pattern_size,
+                              size_t             offset,
+                              size_t             size,
+                              cl_uint            num_events_in_wait_list,
+                              const cl_event*    event_wait_list,
+                              cl_event*          event,
+                              const std::string& hash,
+                              bool               strict)
+{
+  cl_int ret = clEnqueueFillBuffer(command_queue,
+                                   buffer,
+                                   pattern,
+                                   pattern_size,
+                                   offset,
+                                   size,
+                                   num_events_in_wait_list,
+                                   event_wait_list,
+                                   event);
+  return confirm_cl_status(ret, hash, "cl_enqueue_fill_buffer", strict);
+}
+
 Result cl_release_mem_object(cl_mem memobj, const std::string& hash, bool strict)
 {
   cl_int ret = clReleaseMemObject(memobj);
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <sstream>
+#include <miopengemm/error.hpp>
+#include <miopengemm/packedhypas.hpp>
+
+namespace MIOpenGEMM
+{
+
+void PackedHyPas::set(Mat::E emat, size_t hpi, size_t value)
+{
+  const size_t* bits = packing::get_bits(emat);
+  if (value >> bits[hpi] != 0)
+  {
+    std::stringstream errm;
+    errm << "value " << value << " of " << Mat::mat_to_xchi(emat)->name[hpi] << " (in "
+         << Mat::M().name[emat] << ") is too large to pack in " << bits[hpi]
+         << " bits. Consider increasing the width in packedhypas.hpp";
+    throw miog_error(errm.str());
+  }
+
+  size_t   offset = packing::get_offset(bits, hpi);
+  uint64_t mask   = ((uint64_t(1) << bits[hpi]) - 1) << offset;
+  words[emat]     = (words[emat] & ~mask) | (static_cast<uint64_t>(value) << offset);
+}
+
+PackedHyPas::PackedHyPas(const HyPas& hp) : PackedHyPas()
+{
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    for (size_t hpi = 0; hpi < Mat::mat_to_xchi(emat)->N; ++hpi)
+    {
+      set(emat, hpi, hp.sus[emat].vs[hpi]);
+    }
+  }
+}
+
+PackedHyPas::PackedHyPas(const std::string& hp_string) : PackedHyPas(HyPas(hp_string)) {}
+
+HyPas PackedHyPas::get_hypas() const
+{
+  std::array<SuHy, Mat::E::N> sus;
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    std::vector<size_t> vs(Mat::mat_to_xchi(emat)->N);
+    for (size_t hpi = 0; hpi < vs.size(); ++hpi)
+    {
+      vs[hpi] = at(emat, hpi);
+    }
+    sus[emat] = SuHy(emat, std::move(vs));
+  }
+  return HyPas(std::move(sus));
+}
+
+std::string PackedHyPas::get_string() const
+{
+  auto              hp = get_hypas();
+  std::stringstream ss;
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    ss << (emat == Mat::E::A ? "" : "__") << Mat::M().name[emat] << '_'
+       << hp.sus[emat].get_string();
+  }
+  return ss.str();
+}
+
+size_t PackedHyPasHash::operator()(const PackedHyPas& php) const
+{
+  // combine the words, then finalise with the mixer of splitmix64
+  uint64_t h = php.words[Mat::E::A];
+  h          = h * 0x9e3779b97f4a7c15ULL + php.words[Mat::E::B];
+  h          = h * 0x9e3779b97f4a7c15ULL + php.words[Mat::E::C];
+  h          = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  h          = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+  return static_cast<size_t>(h ^ (h >> 31));
+}
+}
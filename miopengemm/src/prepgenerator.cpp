@@ -59,6 +59,50 @@ void PrepGenerator::append_basic_what_definitions(std::stringstream& ss)
      << "#define DIM_UNCOAL " << gg.get_uncoal(emat_x) << "\n\n";
 }
 
+std::string PrepGenerator::get_group_id_string()
+{
+  if (group_id_offset == 0)
+  {
+    return "get_group_id(0)";
+  }
+  std::stringstream ss;
+  ss << "(get_group_id(0) - " << group_id_offset << ")";
+  return ss.str();
+}
+
+void PrepGenerator::append_function(std::stringstream& ss)
+{
+  ss << "void " << kernelname;
+  append_fargs(ss);
+  ss << "{";
+  append_body(ss);
+  ss << "\n}\n\n\n";
+}
+
+void PrepGenerator::append_call(std::stringstream& ss)
+{
+  ss << kernelname << "(" << mchar << ", " << mchar << "_offset, w, w_offset);";
+}
+
+KernBlob PrepGenerator::get_kernelstring()
+{
+  std::stringstream ss;
+  append_definitions(ss);
+
+  ss << "\n\n"
+     << "__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))"
+     << "\n";
+  ss << "__kernel ";
+  append_function(ss);
+
+  return {get_ktype(),
+          {u_a, u_b, u_c, u_w, u_alpha, u_beta},
+          ss.str(),
+          kernelname,
+          get_global_work_size(),
+          get_local_work_size()};
+}
+
 PrepGenerator::PrepGenerator(Mat::E               emat_x_,
                              const HyPas&         hp_,
                              const Geometry&      gg_,
@@ -3,6 +3,7 @@
  *******************************************************************************/
 
 #include <mutex>
+#include <miopengemm/alphagenerator.hpp>
 #include <miopengemm/bundle.hpp>
 #include <miopengemm/gemm.hpp>
 #include <miopengemm/geometry.hpp>
@@ -72,6 +73,26 @@ int ProgramCacher::get_ID_from_geom(const Geometry&   gg,
                 ptr_queue);
 }
 
+namespace
+{
+// the chain kernel synchronises with device scope atomics, which require OpenCL C 2.0 (the
+// device version is of the form "OpenCL <major>.<minor> ...")
+bool has_cl2_atomics(const oclutil::DevInfo& devinfo)
+{
+#ifdef __APPLE__
+  // kernels are not compiled with -cl-std=CL2.0 (see Programs::update)
+  (void)devinfo;
+  return false;
+#else
+  std::string       opencl;
+  int               major = 0;
+  std::stringstream ss(devinfo.device_version);
+  ss >> opencl >> major;
+  return opencl == "OpenCL" && major >= 2;
+#endif
+}
+}
+
 int ProgramCacher::get_ID(bool              isColMajor,
                           bool              tA,
                           bool              tB,
@@ -85,7 +106,8 @@ int ProgramCacher::get_ID(bool              isColMajor,
                           size_t            w_size,
                           BetaType          beta_type,
                           char              floattype,
-                          cl_command_queue* ptr_queue)
+                          cl_command_queue* ptr_queue,
+                          bool              chain)
 {
 
   std::unique_lock<std::mutex> lock(mutt);
@@ -104,7 +126,8 @@ int ProgramCacher::get_ID(bool              isColMajor,
   std::string device_name = info_st.substr(0, info_size - 1);
 
   ss << isColMajor << tA << tB << tC << '.' << m << '.' << n << '.' << k << '.' << lda << '.' << ldb
-     << '.' << ldc << '.' << w_size << '.' << beta_type << '.' << floattype << '.' << device_name;
+     << '.' << ldc << '.' << w_size << '.' << beta_type << '.' << floattype << '.' << device_name
+     << (chain ? ".chain" : "");
 
   auto key = ss.str();
 
@@ -121,25 +144,43 @@ int ProgramCacher::get_ID(bool              isColMajor,
     oclutil::cl_set_command_queue_info(
       *ptr_queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &context, nullptr, "GEMM", true);
 
-    size_t      rank = 0;
-    Constraints constraints("");
+    size_t           rank = 0;
+    oclutil::DevInfo devinfo(*ptr_queue);
+    // without OpenCL 2.0 atomics, a chain of problems is run with the usual kernels, once per
+    // problem (see xgemm_chain)
+    bool chain_kernel = chain && has_cl2_atomics(devinfo);
+
+    // a chain of problems is processed by the (tiled) main kernel alone
+    Constraints constraints(chain_kernel ? "A_WOS0__B_WOS0__C_ICE1_GMV0_IEK0" : "");
     Geometry    gg(isColMajor, tA, tB, tC, lda, ldb, ldc, m, n, k, w_size, floattype);
 
-    oclutil::DevInfo devinfo(*ptr_queue);
-    auto             soln =
+    auto soln =
       get_default_soln(devinfo, gg, constraints, silent_mowri, IfNoCache::E::GENERIC, rank);
 
     std::vector<KernBlob> v_blobs;
 
-    for (auto& x : soln.v_tgks)
+    if (chain_kernel)
     {
-      if (beta_type == BetaType::IsOne && x.e_ktype == KType::E::BETAC)
-      {
-        // don't run the beta kernel.
-      }
-      else
+      // a fixed grid of (at most) one work group per compute unit
+      DerivedParams dp(soln.hypas, gg);
+      size_t        n_persistent_groups =
+        std::max<size_t>(1, std::min(devinfo.device_max_compute_units, dp.main_n_work_groups));
+      v_blobs.push_back(
+        alphagen::get_alpha_chain_kernelstring(soln.hypas, gg, dp, n_persistent_groups));
+    }
+
+    else
+    {
+      for (auto& x : soln.v_tgks)
       {
-        v_blobs.push_back(x);
+        if (beta_type == BetaType::IsOne && x.e_ktype == KType::E::BETAC)
+        {
+          // don't run the beta kernel.
+        }
+        else
+        {
+          v_blobs.push_back(x);
+        }
       }
     }
 
@@ -155,6 +196,7 @@ int ProgramCacher::get_ID(bool              isColMajor,
 
     program_cache[ID] = Programs(device_id, context, silent_mowri);
     hyper_params[ID]  = soln.hypas;
+    chain_kernels[ID] = chain_kernel;
 
     IDs[key] = ID;
 
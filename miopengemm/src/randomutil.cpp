@@ -1,6 +1,7 @@
 /*******************************************************************************
  * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
  *******************************************************************************/
+#include <sstream>
 #include <miopengemm/randomutil.hpp>
 
 namespace MIOpenGEMM
@@ -10,4 +11,21 @@ RandomUtil::RandomUtil() : rd(), gen(rd()) {}
 RandomUtil::RandomUtil(int seed) : rd(), gen(seed) {}
 
 size_t RandomUtil::get_from_range(size_t upper) { return unidis(gen) % upper; }
+
+std::string RandomUtil::get_state() const
+{
+  std::stringstream ss;
+  ss << gen << ' ' << unidis;
+  return ss.str();
+}
+
+void RandomUtil::set_state(const std::string& state)
+{
+  std::stringstream ss(state);
+  ss >> gen >> unidis;
+  if (ss.fail())
+  {
+    throw miog_error("failed to parse the state in RandomUtil::set_state : " + state);
+  }
+}
 }
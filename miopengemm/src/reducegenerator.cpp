@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <sstream>
+#include <miopengemm/reducegenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace reducegen
+{
+
+ReduceGenerator::ReduceGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_)
+
+  : bylinegen::ByLineGenerator(Mat::E::C, hp_, gg_, dp_)
+{
+}
+
+void ReduceGenerator::set_usage()
+{
+  prepgen::PrepGenerator::set_usage();
+  u_w = true;
+}
+
+void ReduceGenerator::set_type() { type = "reduce"; }
+
+size_t ReduceGenerator::get_local_work_size() { return dp.reduce_local_work_size; }
+
+size_t ReduceGenerator::get_work_per_thread() { return dp.reduce_work_per_thread; }
+
+KType::E ReduceGenerator::get_ktype() { return KType::E::REDUCE; }
+
+void ReduceGenerator::setup_additional()
+{
+  description_string = R"(
+/* ****************************************************
+* It is used to complete GEMM split in k (ICE > 1) with DSK, 
+* where the splits have written alpha*A*B of their range of k 
+* to workspace. The partials are summed in a fixed order, 
+* so that C <- alpha*A*B + beta*C is bitwise reproducible
+****************************************************** */ )";
+  inner_work_string = R"(
+/* the sum of the partials, always in the same order */
+TFLOAT sum = 0;
+for (TSHORT z = 0; z < N_PARTIALS; ++z){
+sum += w[((TINTW)z)*N_ELEMENTS_PER_PARTIAL + i];
+}
+if (beta <= 0 && beta >= 0){c[i] = sum;}else{c[i] = beta*c[i] + sum;})";
+}
+
+void ReduceGenerator::append_derived_definitions_additional(std::stringstream& ss)
+{
+  ss << "/* partials have the layout of C, from GLOBAL_OFFSET_W in workspace */\n";
+  ss << "#define LDW " << gg.ldX.at(Mat::E::C) << "\n";
+  ss << "#define GLOBAL_OFFSET_W " << dp.reduce_global_offset << "\n";
+  ss << "#define TINTW " << dp.tints[Mem::E::W] << "\n";
+  ss << "#define N_PARTIALS " << hp.sus[Mat::E::C].vs[NonChi::E::ICE] << "\n";
+  ss << "#define N_ELEMENTS_PER_PARTIAL " << dp.reduce_n_elements_per_partial << "\n";
+}
+
+KernBlob get_reduce_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+{
+  ReduceGenerator rdg(hp, gg, dp);
+  rdg.setup();
+  return rdg.get_kernelstring();
+}
+}
+}
@@ -0,0 +1,277 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <unordered_set>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/error.hpp>
+#include <miopengemm/graph.hpp>
+#include <miopengemm/kernelcache.hpp>
+#include <miopengemm/miogemm.hpp>
+#include <miopengemm/packedhypas.hpp>
+#include <miopengemm/redirection.hpp>
+#include <miopengemm/robustfind.hpp>
+#include <miopengemm/timer.hpp>
+#include <miopengemm/timingstats.hpp>
+
+namespace MIOpenGEMM
+{
+
+RobustSolution::RobustSolution(const std::string& device_, const Constraints& constraints_)
+  : objective(std::numeric_limits<double>::max()), device(device_), constraints(constraints_)
+{
+}
+
+double RobustSolution::get_worst_slowdown() const
+{
+  double worst = 0;
+  for (size_t gi = 0; gi < times.size(); ++gi)
+  {
+    worst = std::max(worst, times[gi] / reference_times[gi]);
+  }
+  return worst;
+}
+
+std::string RobustSolution::get_cache_entries_string() const
+{
+  std::stringstream ss;
+  for (auto& gg : geometries)
+  {
+    ss << get_cache_entry_string({device, constraints, redirection::get_canonical(gg)},
+                                 hypas,
+                                 redirection::get_is_not_canonical(gg))
+       << '\n';
+  }
+  return ss.str();
+}
+
+namespace dev
+{
+
+RobustFind::RobustFind(const std::vector<Geometry>& geometries_,
+                       const std::vector<double>&   weights_,
+                       owrite::Writer&              mowri_,
+                       const CLHint&                xhint)
+  : geometries(geometries_), weights(weights_), mowri(mowri_), devinfo(xhint, mowri_)
+{
+  if (geometries.size() == 0 || geometries.size() != weights.size())
+  {
+    throw miog_error("RobustFind requires at least one geometry, and one weight per geometry");
+  }
+
+  double max_weighted_flops = 0;
+  for (size_t gi = 0; gi < geometries.size(); ++gi)
+  {
+    if (geometries[gi].floattype != geometries[0].floattype)
+    {
+      throw miog_error("the geometries of a RobustFind should all have the same float type");
+    }
+    if (weights[gi] <= 0)
+    {
+      throw miog_error("the weights of a RobustFind should be strictly positive");
+    }
+
+    double weighted_flops =
+      weights[gi] * geometries[gi].m * geometries[gi].n * static_cast<double>(geometries[gi].k);
+    if (weighted_flops > max_weighted_flops)
+    {
+      max_weighted_flops = weighted_flops;
+      dominant           = gi;
+    }
+
+    tinytwos.emplace_back(new TinyTwo(geometries[gi], get_zero_offsets(), silent_mowri, xhint));
+  }
+}
+
+bool RobustFind::is_derivable(const HyPas& hp) const
+{
+  for (auto& gg : geometries)
+  {
+    if (!is_dvble(hp, gg))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<double> RobustFind::get_times(const HyPas& hp, const Halt& hl, SummStat::E sumstat)
+{
+  std::vector<double> times;
+  for (auto& tinytwo : tinytwos)
+  {
+    std::vector<double> runs;
+    try
+    {
+      runs = tinytwo->benchgemm({hp}, hl)[0];
+    }
+    // failed the architests, or did not compile
+    catch (const miog_error&)
+    {
+      return {};
+    }
+    if (runs.size() == 0)
+    {
+      return {};
+    }
+    times.push_back(timingstats::get_summary(runs, sumstat));
+  }
+  return times;
+}
+
+double RobustFind::get_objective(const std::vector<double>& times,
+                                 const std::vector<double>& reference_times,
+                                 RobustObjective::E         objective) const
+{
+  double x = 0;
+  for (size_t gi = 0; gi < times.size(); ++gi)
+  {
+    if (objective == RobustObjective::E::WEIGHTED_TIME)
+    {
+      x += weights[gi] * times[gi];
+    }
+    else
+    {
+      x = std::max(x, times[gi] / reference_times[gi]);
+    }
+  }
+  return x;
+}
+
+RobustSolution RobustFind::find(const FindParams&  fparms,
+                                const Constraints& constraints,
+                                RobustObjective::E objective)
+{
+  Timer timer;
+  timer.start();
+
+  const Graph graph(geometries[dominant], devinfo, constraints, silent_mowri);
+  RobustSolution best(devinfo.identifier, constraints);
+  best.geometries = geometries;
+
+  // the references for slowdowns : the cached solution of each geometry. A geometry whose
+  // cached solution fails is not counted in the worst slowdown.
+  for (size_t gi = 0; gi < geometries.size(); ++gi)
+  {
+    size_t rank = 0;
+    auto   hp   = get_default_soln(
+                devinfo, geometries[gi], constraints, silent_mowri, IfNoCache::E::GENERIC, rank);
+    std::vector<double> runs;
+    try
+    {
+      runs = tinytwos[gi]->benchgemm({hp.hypas}, fparms.hl_core)[0];
+    }
+    catch (const miog_error&)
+    {
+    }
+    best.reference_times.push_back(runs.size() == 0
+                                     ? std::numeric_limits<double>::max()
+                                     : timingstats::get_summary(runs, fparms.sumstat));
+    mowri << "reference " << geometries[gi].get_string() << " : " << best.reference_times.back()
+          << " [ms]" << Endl;
+  }
+
+  // the first descent starts from the cached solution of the dominant geometry, if derivable
+  // for all geometries, later descents from random starts
+  size_t rank = 0;
+  HyPas  start =
+    get_default_soln(
+      devinfo, geometries[dominant], constraints, silent_mowri, IfNoCache::E::RANDOM, rank)
+      .hypas;
+
+  // best is updated as soon as an evaluation improves on it, so none is lost when time runs out
+  auto update_best = [&best](const HyPas& hp, const std::vector<double>& hp_times, double obj) {
+    if (hp_times.size() > 0 && obj < best.objective)
+    {
+      best.hypas     = hp;
+      best.times     = hp_times;
+      best.objective = obj;
+    }
+  };
+
+  std::unordered_set<PackedHyPas, PackedHyPasHash> seen;
+  size_t descents = 0;
+  // the start of the first descent is always benchmarked, even if the references used the budget
+  while (descents == 0 || !fparms.hl_outer.halt(descents, timer.get_elapsed()))
+  {
+    size_t n_tries = 0;
+    while (!is_derivable(start) && n_tries < 1000)
+    {
+      start = graph.get_random_valid_start();
+      ++n_tries;
+    }
+    if (!is_derivable(start))
+    {
+      throw miog_error("RobustFind failed to find a HyPas derivable for all geometries");
+    }
+
+    HyPas  curr     = start;
+    auto   times    = get_times(curr, fparms.hl_core, fparms.sumstat);
+    double curr_obj = times.size() == 0 ? std::numeric_limits<double>::max()
+                                        : get_objective(times, best.reference_times, objective);
+    seen.insert(PackedHyPas(curr));
+    update_best(curr, times, curr_obj);
+
+    mowri << "\ndescent " << descents << " from " << curr.get_string() << " : " << curr_obj
+          << Endl;
+
+    bool improved = true;
+    while (improved && timer.get_elapsed() < fparms.hl_outer.max_time)
+    {
+      improved = false;
+      for (auto& hp : graph.get_neighbors(curr, false, fparms.cost_ordered))
+      {
+        if (timer.get_elapsed() >= fparms.hl_outer.max_time)
+        {
+          break;
+        }
+        if (!seen.insert(PackedHyPas(hp)).second || !is_derivable(hp))
+        {
+          continue;
+        }
+
+        auto hp_times = get_times(hp, fparms.hl_core, fparms.sumstat);
+        if (hp_times.size() == 0)
+        {
+          continue;
+        }
+        double obj = get_objective(hp_times, best.reference_times, objective);
+        mowri << '[' << std::fixed << std::setprecision(2) << timer.get_elapsed()
+              << std::setprecision(6) << "s]\t" << hp.get_string() << "\t" << obj << Endl;
+        update_best(hp, hp_times, obj);
+
+        if (obj < curr_obj)
+        {
+          curr     = hp;
+          times    = hp_times;
+          curr_obj = obj;
+          improved = true;
+          mowri << "(NEW BEST IN DESCENT)" << Endl;
+          break;
+        }
+      }
+    }
+
+    ++descents;
+    start = graph.get_random_valid_start();
+  }
+
+  if (best.times.size() == 0)
+  {
+    throw miog_error("no HyPas ran on all geometries in RobustFind");
+  }
+
+  mowri << '\n' << RobustObjective::M().name[objective] << " : " << best.objective << '\n';
+  for (size_t gi = 0; gi < geometries.size(); ++gi)
+  {
+    mowri << geometries[gi].get_string() << " : " << best.times[gi] << " [ms] ("
+          << best.reference_times[gi] << " [ms] cached)\n";
+  }
+  mowri << Endl;
+  return best;
+}
+}
+}
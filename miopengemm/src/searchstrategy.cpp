@@ -0,0 +1,423 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/error.hpp>
+#include <miopengemm/searchstrategy.hpp>
+
+namespace MIOpenGEMM
+{
+
+namespace
+{
+// length scale of the squared exponential kernel, in log2 units of the features
+const double length_scale = 2.0;
+// noise variance, relative to the (unit) variance of the standardised log times
+const double noise_variance = 0.05;
+// the largest number of evaluated HyPas the model is fitted to (the fastest ones)
+const size_t max_n_train = 256;
+// the number of best HyPas whose neighbors are candidates for proposal
+const size_t n_best_parents = 4;
+// the number of random valid starts which are candidates for proposal
+const size_t n_random_starts = 8;
+// the number of fittest HyPas which are parents in EvolutionarySearch
+const size_t n_population = 16;
+// the number of attempts at a new child, per child requested
+const size_t n_child_attempts = 16;
+
+double get_kernel(const std::vector<double>& a, const std::vector<double>& b)
+{
+  double d2 = 0;
+  for (size_t i = 0; i < a.size(); ++i)
+  {
+    d2 += (a[i] - b[i]) * (a[i] - b[i]);
+  }
+  return std::exp(-d2 / (2 * length_scale * length_scale));
+}
+
+// solves L x = b, L lower triangular
+std::vector<double> forward_substitute(const std::vector<std::vector<double>>& L,
+                                       const std::vector<double>&              b)
+{
+  std::vector<double> x(b.size());
+  for (size_t i = 0; i < b.size(); ++i)
+  {
+    double sum = b[i];
+    for (size_t j = 0; j < i; ++j)
+    {
+      sum -= L[i][j] * x[j];
+    }
+    x[i] = sum / L[i][i];
+  }
+  return x;
+}
+
+// solves L^T x = b, L lower triangular
+std::vector<double> backward_substitute(const std::vector<std::vector<double>>& L,
+                                        const std::vector<double>&              b)
+{
+  std::vector<double> x(b.size());
+  for (size_t ii = b.size(); ii > 0; --ii)
+  {
+    size_t i   = ii - 1;
+    double sum = b[i];
+    for (size_t j = i + 1; j < b.size(); ++j)
+    {
+      sum -= L[j][i] * x[j];
+    }
+    x[i] = sum / L[i][i];
+  }
+  return x;
+}
+}
+
+bool is_proposable(const HyPas&                                            hp,
+                   const Graph&                                            graph,
+                   const Geometry&                                         gg,
+                   const std::unordered_set<PackedHyPas, PackedHyPasHash>& proposed)
+{
+  return proposed.count(PackedHyPas(hp)) == 0 && graph.contains(hp) && is_dvble(hp, gg);
+}
+
+std::vector<double> get_features(const HyPas& hp, const Geometry& gg)
+{
+  std::vector<double> features;
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    for (auto& v : hp.sus[emat].vs)
+    {
+      features.push_back(std::log2(1. + v));
+    }
+  }
+  for (auto x : {gg.m, gg.n, gg.k})
+  {
+    features.push_back(std::log2(static_cast<double>(x)));
+  }
+  return features;
+}
+
+SurrogateSearch::SurrogateSearch(const Graph&              graph_,
+                                 const Geometry&           gg_,
+                                 const std::vector<HyPas>& seeds_)
+  : graph(graph_), gg(gg_), seeds(seeds_)
+{
+}
+
+bool SurrogateSearch::try_propose(const HyPas& hp, std::vector<HyPas>& proposals)
+{
+  if (!is_proposable(hp, graph, gg, proposed))
+  {
+    return false;
+  }
+  proposed.insert(PackedHyPas(hp));
+  proposals.push_back(hp);
+  return true;
+}
+
+void SurrogateSearch::observe(const HyPas& hp, double time)
+{
+  x_hps.push_back(hp);
+  x_features.push_back(get_features(hp, gg));
+  times.push_back(time);
+}
+
+void SurrogateSearch::fit()
+{
+  // failed HyPas are modelled as twice as slow as the slowest which ran
+  double max_ok = 0;
+  for (auto& t : times)
+  {
+    if (t < std::numeric_limits<double>::max())
+    {
+      max_ok = std::max(max_ok, t);
+    }
+  }
+  double t_fail = max_ok > 0 ? 2 * max_ok : 1.;
+
+  train.resize(times.size());
+  std::iota(train.begin(), train.end(), 0);
+  std::stable_sort(
+    train.begin(), train.end(), [this](size_t a, size_t b) { return times[a] < times[b]; });
+  train.resize(std::min(train.size(), max_n_train));
+
+  std::vector<double> y(train.size());
+  for (size_t i = 0; i < train.size(); ++i)
+  {
+    double t = times[train[i]];
+    y[i]     = std::log(t < std::numeric_limits<double>::max() ? t : t_fail);
+  }
+
+  y_mean     = std::accumulate(y.begin(), y.end(), 0.) / y.size();
+  double var = 0;
+  for (auto& x : y)
+  {
+    var += (x - y_mean) * (x - y_mean) / y.size();
+  }
+  y_scale = std::max(1e-3, std::sqrt(var));
+  for (auto& x : y)
+  {
+    x = (x - y_mean) / y_scale;
+  }
+  y_best = *std::min_element(y.begin(), y.end());
+
+  // Cholesky factorisation of the kernel matrix
+  size_t N = train.size();
+  chol.assign(N, std::vector<double>(N, 0));
+  for (size_t i = 0; i < N; ++i)
+  {
+    for (size_t j = 0; j <= i; ++j)
+    {
+      double sum = get_kernel(x_features[train[i]], x_features[train[j]]);
+      if (i == j)
+      {
+        sum += noise_variance;
+      }
+      for (size_t l = 0; l < j; ++l)
+      {
+        sum -= chol[i][l] * chol[j][l];
+      }
+      chol[i][j] = (i == j) ? std::sqrt(std::max(sum, 1e-12)) : sum / chol[j][j];
+    }
+  }
+
+  alpha = backward_substitute(chol, forward_substitute(chol, y));
+}
+
+double SurrogateSearch::get_expected_improvement(const std::vector<double>& features) const
+{
+  std::vector<double> k_star(train.size());
+  for (size_t i = 0; i < train.size(); ++i)
+  {
+    k_star[i] = get_kernel(features, x_features[train[i]]);
+  }
+
+  double mu    = std::inner_product(k_star.begin(), k_star.end(), alpha.begin(), 0.);
+  auto   v     = forward_substitute(chol, k_star);
+  double var   = 1. - std::inner_product(v.begin(), v.end(), v.begin(), 0.);
+  double sigma = std::sqrt(std::max(var, 1e-12));
+
+  double z   = (y_best - mu) / sigma;
+  double cdf = 0.5 * std::erfc(-z / std::sqrt(2.));
+  double pdf = std::exp(-0.5 * z * z) / std::sqrt(2. * std::acos(-1.));
+  return sigma * (z * cdf + pdf);
+}
+
+std::vector<HyPas> SurrogateSearch::propose(size_t n)
+{
+  std::vector<HyPas> proposals;
+
+  // seeds first, in order
+  while (proposals.size() < n && seeds.size() > 0)
+  {
+    try_propose(seeds.front(), proposals);
+    seeds.erase(seeds.begin());
+  }
+
+  if (proposals.size() == n)
+  {
+    return proposals;
+  }
+
+  // without observations there is no model, so random valid starts
+  if (times.size() == 0)
+  {
+    for (size_t i = 0; i < n_random_starts && proposals.size() < n; ++i)
+    {
+      try_propose(graph.get_random_valid_start(), proposals);
+    }
+    return proposals;
+  }
+
+  fit();
+
+  // the pool of candidates : neighbors of the best evaluated HyPas, and random valid starts
+  std::vector<HyPas>                               pool;
+  std::unordered_set<PackedHyPas, PackedHyPasHash> in_pool;
+  auto add_to_pool = [this, &pool, &in_pool](const HyPas& hp) {
+    if (is_proposable(hp, graph, gg, proposed) && in_pool.insert(PackedHyPas(hp)).second)
+    {
+      pool.push_back(hp);
+    }
+  };
+
+  for (size_t i = 0; i < std::min(n_best_parents, train.size()); ++i)
+  {
+    if (times[train[i]] < std::numeric_limits<double>::max())
+    {
+      for (auto& hp : graph.get_neighbors(x_hps[train[i]], false))
+      {
+        add_to_pool(hp);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < n_random_starts; ++i)
+  {
+    add_to_pool(graph.get_random_valid_start());
+  }
+
+  std::vector<double> acquisition(pool.size());
+  for (size_t i = 0; i < pool.size(); ++i)
+  {
+    acquisition[i] = get_expected_improvement(get_features(pool[i], gg));
+  }
+
+  std::vector<size_t> order(pool.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&acquisition](size_t a, size_t b) {
+    return acquisition[a] > acquisition[b];
+  });
+
+  for (size_t i = 0; i < order.size() && proposals.size() < n; ++i)
+  {
+    try_propose(pool[order[i]], proposals);
+  }
+
+  return proposals;
+}
+
+EvolutionarySearch::EvolutionarySearch(const Graph&              graph_,
+                                       const Geometry&           gg_,
+                                       const std::vector<HyPas>& seeds_,
+                                       size_t                    population_size_)
+  : graph(graph_), gg(gg_), seeds(seeds_), population_size(population_size_), radutil(1011)
+{
+  if (population_size == 0)
+  {
+    throw miog_error("population_size should be strictly positive, in EvolutionarySearch");
+  }
+}
+
+bool EvolutionarySearch::try_propose(const HyPas& hp, std::vector<HyPas>& proposals)
+{
+  if (!is_proposable(hp, graph, gg, proposed))
+  {
+    return false;
+  }
+  proposed.insert(PackedHyPas(hp));
+  proposals.push_back(hp);
+  return true;
+}
+
+void EvolutionarySearch::observe(const HyPas& hp, double time)
+{
+  evaluated[PackedHyPas(hp)] = time;
+  if (time == std::numeric_limits<double>::max())
+  {
+    return;
+  }
+
+  auto it = std::upper_bound(
+    population.begin(), population.end(), time, [this](double t, const HyPas& x) {
+      return t < evaluated.at(PackedHyPas(x));
+    });
+  population.insert(it, hp);
+  if (population.size() > population_size)
+  {
+    population.pop_back();
+  }
+}
+
+const HyPas& EvolutionarySearch::get_tournament_winner()
+{
+  // the population is sorted, so the lower index wins
+  size_t i0 = radutil.get_from_range(population.size());
+  size_t i1 = radutil.get_from_range(population.size());
+  return population[std::min(i0, i1)];
+}
+
+HyPas EvolutionarySearch::get_crossover(const HyPas& hp0, const HyPas& hp1)
+{
+  HyPas child(hp0);
+  for (auto emat : {Mat::E::A, Mat::E::B, Mat::E::C})
+  {
+    if (radutil.get_from_range(2) == 1)
+    {
+      child.sus[emat] = hp1.sus[emat];
+    }
+  }
+  return child;
+}
+
+bool EvolutionarySearch::set_mutated(const HyPas& hp, HyPas& mutant)
+{
+  // get_neighbors returns neighbors in random order
+  for (auto& neighbor : graph.get_neighbors(hp, false))
+  {
+    if (graph.contains(neighbor) && is_dvble(neighbor, gg))
+    {
+      mutant = neighbor;
+      return true;
+    }
+  }
+  return false;
+}
+
+std::vector<HyPas> EvolutionarySearch::propose(size_t n)
+{
+  std::vector<HyPas> proposals;
+
+  while (proposals.size() < n && seeds.size() > 0)
+  {
+    try_propose(seeds.front(), proposals);
+    seeds.erase(seeds.begin());
+  }
+
+  for (size_t attempt = 0;
+       population.size() > 0 && proposals.size() < n && attempt < n * n_child_attempts;
+       ++attempt)
+  {
+    const HyPas& parent0 = get_tournament_winner();
+    HyPas        child   = parent0;
+    bool         crossed = false;
+    if (population.size() > 1 && radutil.get_from_range(2) == 1)
+    {
+      child   = get_crossover(parent0, get_tournament_winner());
+      crossed = !(child == parent0);
+    }
+
+    // mutate if the child is a parent, half the time otherwise, and to repair
+    if (!crossed || radutil.get_from_range(2) == 1 || !is_dvble(child, gg))
+    {
+      HyPas mutant;
+      if (!set_mutated(child, mutant))
+      {
+        continue;
+      }
+      child = mutant;
+    }
+
+    try_propose(child, proposals);
+  }
+
+  // immigrants, when there are no parents or their offspring have all been proposed
+  for (size_t i = 0; i < n_random_starts && proposals.size() < n; ++i)
+  {
+    try_propose(graph.get_random_valid_start(), proposals);
+  }
+
+  return proposals;
+}
+
+std::unique_ptr<SearchStrategy> get_search_strategy(SearchType::E             search,
+                                                    const Graph&              graph,
+                                                    const Geometry&           gg,
+                                                    const std::vector<HyPas>& seeds)
+{
+  switch (search)
+  {
+  case SearchType::E::SURROGATE:
+    return std::unique_ptr<SearchStrategy>(new SurrogateSearch(graph, gg, seeds));
+  case SearchType::E::EVOLUTION:
+    return std::unique_ptr<SearchStrategy>(new EvolutionarySearch(graph, gg, seeds, n_population));
+  case SearchType::E::DESCENT:
+    throw miog_error("DESCENT is not a SearchStrategy, it is single_descent_find");
+  case SearchType::E::N: throw miog_error("N not allowed in get_search_strategy");
+  }
+  throw miog_error("unrecognised SearchType in get_search_strategy");
+}
+}
@@ -0,0 +1,283 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <sstream>
+#include <miopengemm/skinnygenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace skinnygen
+{
+
+class SkinnyGenerator : public basegen::BaseGenerator
+{
+
+  private:
+  // A is contiguous along k (otherwise along m)
+  bool a_pll_k;
+  size_t vew;
+
+  public:
+  SkinnyGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_)
+    : basegen::BaseGenerator(hp_, gg_, dp_),
+      a_pll_k(gg_.coal_is_pll_k(Mat::E::A)),
+      vew(hp_.sus[Mat::E::A].vs[Chi::E::VEW])
+  {
+  }
+
+  private:
+  virtual void set_type() override final { type = "skinny"; }
+
+  virtual void set_usage() override final
+  {
+    u_a     = true;
+    u_b     = true;
+    u_c     = true;
+    u_w     = false;
+    u_alpha = true;
+    u_beta  = true;
+  }
+
+  virtual void setup_final() override final {}
+
+  virtual size_t get_local_work_size() override final
+  {
+    return dp.main_n_work_items_per_workgroup;
+  }
+
+  virtual size_t get_n_work_groups() override final { return dp.at(Mat::E::A).n_groups; }
+
+  // element (i, u) of the fragment of A, i along m and u along k. It is stored contiguous in
+  // the dimension in which A is, so that it can be loaded with vstore
+  std::string get_ra(const std::string& i, const std::string& u)
+  {
+    return a_pll_k ? "rA[" + i + "][" + u + "]" : "rA[" + u + "][" + i + "]";
+  }
+
+  void append_fma(std::stringstream& ss, const std::string& a_elm, const std::string& b_elm)
+  {
+    if (hp.sus[Mat::E::C].vs[NonChi::E::MAD] == Binary::E::NO)
+    {
+      ss << "rC[i][j] += " << a_elm << "*" << b_elm << ";\n";
+    }
+    else
+    {
+      ss << "rC[i][j] = mad(" << a_elm << ", " << b_elm << ", rC[i][j]);\n";
+    }
+  }
+
+  void append_load_a(std::stringstream& ss)
+  {
+    std::string outer = a_pll_k ? "i" : "u";
+    std::string inner = a_pll_k ? "u" : "i";
+    std::string src   = a_pll_k ? "a_row + STRIDE_PERP_K_A*i + k_start + u"
+                              : "a_row + STRIDE_PLL_K_A*((TINTA)(k_start + u)) + i";
+
+    ss << "\n/* the fragment of A, VEW_A elements at a time along its contiguous dimension */\n"
+       << dp.pragma_unroll_string << "for (TSHORT " << outer << " = 0; " << outer << " < "
+       << (a_pll_k ? "MICRO_TILE_LENGTH_A" : "UNROLL") << "; ++" << outer << "){\n"
+       << dp.pragma_unroll_string << "for (TSHORT " << inner << " = 0; " << inner << " < "
+       << (a_pll_k ? "UNROLL" : "MICRO_TILE_LENGTH_A") << "; " << inner << " += VEW_A){\n";
+    if (vew == 1)
+    {
+      ss << get_ra("i", "u") << " = *(" << src << ");\n";
+    }
+    else
+    {
+      ss << "vstore" << vew << "(vload" << vew << "(0, " << src << "), 0, &" << get_ra("i", "u")
+         << ");\n";
+    }
+    ss << "}\n}\n";
+  }
+
+  void append_write(std::stringstream& ss, const std::string& col, const std::string& sum)
+  {
+    // the rows of the pulled in final group which are in the previous group are left to it
+    if (dp.main_use_edge_trick == 1)
+    {
+      ss << "if (group_id != N_GROUPS - 1 || row >= (N_GROUPS - 1)*ROWS_PER_GROUP){\n";
+    }
+    ss << "const TINTC index = STRIDE_PLL_M_C*((TINTC)row) + STRIDE_PLL_N_C*" << col << ";\n"
+       << "if (beta >= 0 && beta <= 0){\nc[index] = alpha*" << sum << ";\n}\n"
+       << "else{\nc[index] = beta*c[index] + alpha*" << sum << ";\n}\n";
+    if (dp.main_use_edge_trick == 1)
+    {
+      ss << "}\n";
+    }
+  }
+
+  public:
+  virtual KType::E get_ktype() override final { return KType::E::MAIN; }
+
+  virtual KernBlob get_kernelstring() override final
+  {
+
+    std::stringstream ss;
+    ss << get_time_string();
+    ss << R"(
+/* ****************************************************
+* It computes C <- alpha*A*B + beta*C for small n, as in
+* matrix-vector products and inference with small batches.
+* Such GEMMs are bound by reading A, so A is streamed
+* once from global memory, without LDS tiles. Each work
+* item keeps rows of B (all n columns) in registers. Work
+* items along k reduce their partial sums at the end
+****************************************************** */ )";
+
+    ss << "\n\n" << get_what_string() << "\n";
+    ss << "#define TFLOAT " << dp.t_float << '\n'
+       << "#define N_COLS " << gg.n << '\n'
+       << "#define K_DIM " << gg.k << '\n';
+    for (auto emat_x : {Mat::E::A, Mat::E::B})
+    {
+      char X = Mat::M().name[emat_x];
+      ss << "#define STRIDE_PLL_K_" << X << ' ' << dp.get_stride_cw0(emat_x, true) << '\n'
+         << "#define STRIDE_PERP_K_" << X << ' ' << dp.get_stride_cw0(emat_x, false) << '\n';
+    }
+    append_stride_c_defn(ss);
+
+    ss << get_how_string() << "\n";
+    ss << "/* rows of A processed by a work item */\n"
+       << "#define MICRO_TILE_LENGTH_A " << hp.sus[Mat::E::A].vs[Chi::E::MIC] << '\n'
+       << "/* elements of k processed by a work item at a time */\n"
+       << "#define UNROLL " << hp.sus[Mat::E::C].vs[NonChi::E::UNR] << '\n'
+       << "#define VEW_A " << vew << '\n'
+       << "#define N_WORK_ITEMS_PER_GROUP " << get_local_work_size() << '\n';
+
+    ss << get_derived_string() << "\n";
+    ss << "#define N_WORK_ITEMS_PLL_M " << dp.skinny_n_work_items_pll_m << '\n'
+       << "#define N_WORK_ITEMS_PLL_K " << dp.skinny_n_work_items_pll_k << '\n'
+       << "#define ROWS_PER_GROUP " << dp.at(Mat::E::A).macro_tile_length << '\n'
+       << "#define N_GROUPS " << dp.at(Mat::E::A).n_groups << '\n';
+    if (dp.main_use_edge_trick == 1)
+    {
+      ss << "#define PRESHIFT_FINAL_TILE " << dp.at(Mat::E::A).preshift_final_tile << '\n';
+    }
+    ss << "#define N_FULL_UNROLLS " << gg.k / hp.sus[Mat::E::C].vs[NonChi::E::UNR] << '\n'
+       << "#define TINTA " << dp.tints[Mem::E::A] << '\n'
+       << "#define TINTB " << dp.tints[Mem::E::B] << '\n'
+       << "#define TINTC " << dp.tints[Mem::E::C] << '\n'
+       << "/* the unroll loop overshoots K_DIM by up to N_WORK_ITEMS_PLL_K*UNROLL */\n"
+       << "#define TINTK "
+       << (hp.sus[Mat::E::C].vs[NonChi::E::SZT] == Binary::E::YES ? "ulong" : "unsigned") << '\n'
+       << "#define TSHORT " << dp.tshort << '\n';
+
+    ss << "\n\n__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))\n"
+       << "__kernel void " << kernelname;
+    append_fargs(ss);
+
+    ss << "{\n\na += a_offset;\nb += b_offset;\nc += c_offset;\n\n"
+       << "const TSHORT local_id = (TSHORT)(get_local_id(0));\n"
+       << "/* adjacent work items are adjacent along the contiguous dimension of A */\n";
+    if (a_pll_k)
+    {
+      ss << "const TSHORT id_k = local_id % N_WORK_ITEMS_PLL_K;\n"
+         << "const TSHORT id_m = local_id / N_WORK_ITEMS_PLL_K;\n";
+    }
+    else
+    {
+      ss << "const TSHORT id_m = local_id % N_WORK_ITEMS_PLL_M;\n"
+         << "const TSHORT id_k = local_id / N_WORK_ITEMS_PLL_M;\n";
+    }
+
+    ss << "\nconst TINTA group_id = (TINTA)(get_group_id(0));\n"
+       << "TINTA group_start = group_id*ROWS_PER_GROUP;\n";
+    if (dp.main_use_edge_trick == 1)
+    {
+      ss << "/* the final group is pulled in, to end at the final row */\n"
+         << "if (group_id == N_GROUPS - 1){\n"
+         << "group_start -= (ROWS_PER_GROUP - PRESHIFT_FINAL_TILE);\n}\n";
+    }
+    ss << "const TINTA row_start = group_start + id_m*MICRO_TILE_LENGTH_A;\n"
+       << "const __global TFLOAT * restrict a_row = a + STRIDE_PERP_K_A*row_start;\n";
+
+    if (dp.skinny_n_work_items_pll_k != 1)
+    {
+      ss << "\n/* the partial sums of the work items along k, for one row of their rows */\n"
+         << "__local TFLOAT partials[N_WORK_ITEMS_PER_GROUP*N_COLS];\n";
+    }
+
+    ss << "\nTFLOAT rC[MICRO_TILE_LENGTH_A][N_COLS];\n"
+       << (a_pll_k ? "TFLOAT rA[MICRO_TILE_LENGTH_A][UNROLL];\n"
+                   : "TFLOAT rA[UNROLL][MICRO_TILE_LENGTH_A];\n")
+       << "TFLOAT rB[UNROLL][N_COLS];\n\n"
+       << dp.pragma_unroll_string << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_A; ++i){\n"
+       << dp.pragma_unroll_string << "for (TSHORT j = 0; j < N_COLS; ++j){\nrC[i][j] = 0;\n}\n}\n";
+
+    ss << "\n/* the unrolls are interleaved between the work items along k */\n"
+       << "for (TINTK unroll_i = id_k; unroll_i < N_FULL_UNROLLS; "
+          "unroll_i += N_WORK_ITEMS_PLL_K){\n"
+       << "const TINTK k_start = unroll_i*UNROLL;\n"
+       << "\n/* the fragment of B, all columns */\n"
+       << dp.pragma_unroll_string << "for (TSHORT u = 0; u < UNROLL; ++u){\n"
+       << dp.pragma_unroll_string << "for (TSHORT j = 0; j < N_COLS; ++j){\n"
+       << "rB[u][j] = b[STRIDE_PLL_K_B*((TINTB)(k_start + u)) + STRIDE_PERP_K_B*j];\n}\n}\n";
+    append_load_a(ss);
+    ss << '\n'
+       << dp.pragma_unroll_string << "for (TSHORT u = 0; u < UNROLL; ++u){\n"
+       << dp.pragma_unroll_string << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_A; ++i){\n"
+       << dp.pragma_unroll_string << "for (TSHORT j = 0; j < N_COLS; ++j){\n";
+    append_fma(ss, get_ra("i", "u"), "rB[u][j]");
+    ss << "}\n}\n}\n}\n";
+
+    if (dp.main_final_fractional_unroll == 1)
+    {
+      ss << "\n/* the final fractional unroll, one k at a time */\n"
+         << "for (TINTK k_i = N_FULL_UNROLLS*UNROLL + id_k; k_i < K_DIM; "
+            "k_i += N_WORK_ITEMS_PLL_K){\n"
+         << "for (TSHORT j = 0; j < N_COLS; ++j){\n"
+         << "rB[0][j] = b[STRIDE_PLL_K_B*((TINTB)k_i) + STRIDE_PERP_K_B*j];\n}\n"
+         << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_A; ++i){\n"
+         << "const TFLOAT a_ik = a_row[STRIDE_PERP_K_A*i + STRIDE_PLL_K_A*((TINTA)k_i)];\n"
+         << "for (TSHORT j = 0; j < N_COLS; ++j){\n";
+      append_fma(ss, "a_ik", "rB[0][j]");
+      ss << "}\n}\n}\n";
+    }
+
+    if (dp.skinny_n_work_items_pll_k == 1)
+    {
+      ss << "\n/* a work item has the complete sums of its rows */\n"
+         << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_A; ++i){\n"
+         << "const TINTA row = row_start + i;\n"
+         << "for (TSHORT j = 0; j < N_COLS; ++j){\n";
+      append_write(ss, "j", "rC[i][j]");
+      ss << "}\n}\n";
+    }
+
+    else
+    {
+      ss << "\n/* the work items along k reduce their partial sums, a row at a time. The sums "
+            "are in a fixed order */\n"
+         << "for (TSHORT i = 0; i < MICRO_TILE_LENGTH_A; ++i){\n"
+         << "for (TSHORT j = 0; j < N_COLS; ++j){\n"
+         << "partials[(id_k*N_WORK_ITEMS_PLL_M + id_m)*N_COLS + j] = rC[i][j];\n}\n"
+         << "barrier(CLK_LOCAL_MEM_FENCE);\n"
+         << "for (TSHORT e = local_id; e < N_WORK_ITEMS_PLL_M*N_COLS; "
+            "e += N_WORK_ITEMS_PER_GROUP){\n"
+         << "TFLOAT sum = 0;\n"
+         << "for (TSHORT z = 0; z < N_WORK_ITEMS_PLL_K; ++z){\n"
+         << "sum += partials[z*N_WORK_ITEMS_PLL_M*N_COLS + e];\n}\n"
+         << "const TINTA row = group_start + (e / N_COLS)*MICRO_TILE_LENGTH_A + i;\n";
+      append_write(ss, "(e % N_COLS)", "sum");
+      ss << "}\nbarrier(CLK_LOCAL_MEM_FENCE);\n}\n";
+    }
+
+    ss << "}\n";
+
+    return {get_ktype(),
+            {u_a, u_b, u_c, u_w, u_alpha, u_beta},
+            ss.str(),
+            kernelname,
+            get_n_work_groups() * get_local_work_size(),
+            get_local_work_size()};
+  }
+};
+
+KernBlob get_skinny_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+{
+  SkinnyGenerator skg(hp, gg, dp);
+  skg.setup();
+  return skg.get_kernelstring();
+}
+}
+}
@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <sstream>
+#include <miopengemm/streamkgenerator.hpp>
+
+namespace MIOpenGEMM
+{
+namespace streamkgen
+{
+
+class StreamKGenerator : public basegen::BaseGenerator
+{
+
+  public:
+  StreamKGenerator(const HyPas& hp_, const Geometry& gg_, const DerivedParams& dp_)
+    : basegen::BaseGenerator(hp_, gg_, dp_)
+  {
+  }
+
+  private:
+  virtual void set_type() override final { type = "streamk"; }
+
+  virtual void set_usage() override final
+  {
+    u_a     = false;
+    u_b     = false;
+    u_c     = true;
+    u_w     = true;
+    u_alpha = true;
+    u_beta  = true;
+  }
+
+  virtual void setup_final() override final {}
+
+  virtual size_t get_local_work_size() override final { return dp.reduce_local_work_size; }
+
+  virtual size_t get_n_work_groups() override final
+  {
+    return dp.at(Mat::E::A).n_groups * dp.at(Mat::E::B).n_groups;
+  }
+
+  public:
+  virtual KType::E get_ktype() override final { return KType::E::REDUCE; }
+
+  virtual KernBlob get_kernelstring() override final
+  {
+
+    std::stringstream ss;
+    ss << get_time_string();
+    ss << R"(
+/* ****************************************************
+* It completes GEMM with Stream-K (GAL STREAMK), where 
+* the persistent work groups have written the partial 
+* tiles of the tiles which they share to workspace. 
+* The partials are summed in the order of the work groups, 
+* so that C <- alpha*A*B + beta*C is bitwise reproducible
+****************************************************** */ )";
+
+    ss << "\n\n" << get_what_string() << "\n";
+    ss << "#define TFLOAT " << dp.t_float << '\n';
+    append_stride_c_defn(ss);
+    ss << "#define MACRO_TILE_LENGTH_A " << dp.at(Mat::E::A).macro_tile_length << '\n'
+       << "#define MACRO_TILE_LENGTH_B " << dp.at(Mat::E::B).macro_tile_length << '\n'
+       << "#define PRESHIFT_FINAL_TILE_A " << dp.at(Mat::E::A).preshift_final_tile << '\n'
+       << "#define PRESHIFT_FINAL_TILE_B " << dp.at(Mat::E::B).preshift_final_tile << '\n'
+       << "#define N_GROUPS_A " << dp.at(Mat::E::A).n_groups << '\n'
+       << "#define N_GROUPS_B " << dp.at(Mat::E::B).n_groups << '\n';
+
+    ss << get_how_string() << "\n";
+    ss << "#define N_WORK_ITEMS_PER_GROUP " << get_local_work_size() << '\n'
+       << "#define N_PERSISTENT_GROUPS " << dp.main_n_work_groups << '\n'
+       << "#define ITERATIONS_PER_TILE " << dp.main_sk_iterations_per_tile << '\n'
+       << "#define N_SK_ITERATIONS " << dp.main_sk_n_iterations << "UL\n";
+
+    ss << get_derived_string() << "\n";
+    ss << "/* the partial tiles, 2 per persistent work group, have the layout of a macro tile */\n"
+       << "#define GLOBAL_OFFSET_PARTIALS " << dp.reduce_global_offset << '\n'
+       << "#define N_ELEMENTS_PER_PARTIAL " << dp.reduce_n_elements_per_partial << '\n'
+       << "#define TINTC " << dp.tints[Mem::E::C] << '\n'
+       << "#define TINTW " << dp.tints[Mem::E::W] << '\n';
+
+    ss << R"(
+/* the first iteration of persistent work group p */
+#define SK_FIRST(p) ((((ulong)(p))*N_SK_ITERATIONS)/N_PERSISTENT_GROUPS)
+/* the persistent work group which processes iteration i */
+#define SK_OWNER(i) \
+  (((((ulong)(i)) + 1)*N_PERSISTENT_GROUPS + N_SK_ITERATIONS - 1)/N_SK_ITERATIONS - 1)
+)";
+
+    ss << "\n\n__attribute__((reqd_work_group_size(N_WORK_ITEMS_PER_GROUP,1,1)))\n"
+       << "__kernel void " << kernelname;
+    append_fargs(ss);
+
+    ss << R"({
+
+/* the tile of this work group, ordered column-by-column as in the main kernel */
+const TINTC tile_id = get_group_id(0);
+const ulong p_first = SK_OWNER(((ulong)tile_id)*ITERATIONS_PER_TILE);
+const ulong p_last = SK_OWNER(((ulong)tile_id + 1)*ITERATIONS_PER_TILE - 1);
+
+/* a tile processed entirely by one work group was written by the main kernel */
+if (p_first == p_last){
+return;
+}
+
+const TINTC group_id_a = tile_id % N_GROUPS_A;
+const TINTC group_id_b = tile_id / N_GROUPS_A;
+
+/* the final tiles are pulled in, as in the main kernel */
+TINTC tile_start_a = group_id_a*MACRO_TILE_LENGTH_A;
+if (group_id_a == N_GROUPS_A - 1){
+tile_start_a -= (MACRO_TILE_LENGTH_A - PRESHIFT_FINAL_TILE_A);
+}
+TINTC tile_start_b = group_id_b*MACRO_TILE_LENGTH_B;
+if (group_id_b == N_GROUPS_B - 1){
+tile_start_b -= (MACRO_TILE_LENGTH_B - PRESHIFT_FINAL_TILE_B);
+}
+
+c += c_offset;
+w += w_offset + GLOBAL_OFFSET_PARTIALS;
+
+for (TINTW e = get_local_id(0); e < MACRO_TILE_LENGTH_A*MACRO_TILE_LENGTH_B; 
+     e += N_WORK_ITEMS_PER_GROUP){
+const TINTC pos_a = tile_start_a + e % MACRO_TILE_LENGTH_A;
+const TINTC pos_b = tile_start_b + e / MACRO_TILE_LENGTH_A;
+
+/* elements of a pulled in final tile which are in the previous tile belong to that tile */
+if ((group_id_a == N_GROUPS_A - 1 && pos_a < MACRO_TILE_LENGTH_A*(N_GROUPS_A - 1)) || 
+    (group_id_b == N_GROUPS_B - 1 && pos_b < MACRO_TILE_LENGTH_B*(N_GROUPS_B - 1))){
+continue;
+}
+
+/* the sum of the partials, always in the same order. Work group p_first wrote to its second 
+ * slot, unless this tile is where it starts, the others to their first */
+TFLOAT sum = 0;
+for (ulong p = p_first; p <= p_last; ++p){
+const TINTW slot = 2*p + (SK_FIRST(p) < ((ulong)tile_id)*ITERATIONS_PER_TILE);
+sum += w[slot*N_ELEMENTS_PER_PARTIAL + e];
+}
+
+const TINTC index = STRIDE_PLL_M_C*pos_a + STRIDE_PLL_N_C*pos_b;
+if (beta <= 0 && beta >= 0){c[index] = alpha*sum;}else{c[index] = beta*c[index] + alpha*sum;}
+}
+}
+)";
+
+    return {get_ktype(),
+            {u_a, u_b, u_c, u_w, u_alpha, u_beta},
+            ss.str(),
+            kernelname,
+            get_n_work_groups() * get_local_work_size(),
+            get_local_work_size()};
+  }
+};
+
+KernBlob get_stream_k_kernelstring(const HyPas& hp, const Geometry& gg, const DerivedParams& dp)
+{
+  StreamKGenerator skg(hp, gg, dp);
+  skg.setup();
+  return skg.get_kernelstring();
+}
+}
+}
@@ -12,30 +12,31 @@ namespace MIOpenGEMM
 namespace tiling
 {
 
-std::vector<size_t> get_multiples(size_t N)
+void set_tile_dimensions_no_checks(size_t& tH, size_t& tW, size_t TH, size_t TW, size_t tS)
 {
-  std::vector<size_t> multiples;
-  for (size_t k = N; k > 0; --k)
+  // multiples of TH, largest first
+  for (size_t multiple_of_TH = TH; multiple_of_TH > 0; --multiple_of_TH)
   {
-    if (N % k == 0)
+    if ((TH % multiple_of_TH == 0) && (tS % multiple_of_TH == 0) &&
+        ((tS / multiple_of_TH) <= TW))
     {
-      multiples.push_back(k);
+      tH = multiple_of_TH;
+      tW = tS / tH;
+      break;
     }
   }
-  return multiples;
 }
 
-void set_tile_dimensions_no_checks(size_t& tH, size_t& tW, size_t TH, size_t TW, size_t tS)
+bool is_tileable(size_t TH, size_t TW, size_t tS)
 {
-  for (auto& multiple_of_TH : get_multiples(TH))
+  if (tS == 0)
   {
-    if ((tS % multiple_of_TH == 0) && ((tS / multiple_of_TH) <= TW))
-    {
-      tH = multiple_of_TH;
-      tW = tS / tH;
-      break;
-    }
+    return false;
   }
+  size_t tH = 0;
+  size_t tW = 0;
+  set_tile_dimensions_no_checks(tH, tW, TH, TW, tS);
+  return tW != 0 && TW % tW == 0 && tW * tH == tS;
 }
 
 std::tuple<bool, std::string> get_tileability(size_t TH, size_t TW, size_t tS)
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <miopengemm/error.hpp>
+#include <miopengemm/timingstats.hpp>
+
+namespace MIOpenGEMM
+{
+namespace timingstats
+{
+
+namespace
+{
+// the median of sorted times
+double get_median(const std::vector<double>& times)
+{
+  size_t n = times.size();
+  return n % 2 == 1 ? times[n / 2] : 0.5 * (times[n / 2 - 1] + times[n / 2]);
+}
+
+std::vector<double> get_resample(const std::vector<double>& times, std::mt19937& gen)
+{
+  std::uniform_int_distribution<size_t> dis(0, times.size() - 1);
+  std::vector<double>                   resample(times.size());
+  for (auto& x : resample)
+  {
+    x = times[dis(gen)];
+  }
+  return resample;
+}
+}
+
+double get_summary(const std::vector<double>& times, SummStat::E sumstat)
+{
+  if (times.size() == 0)
+  {
+    throw miog_error("no times, in get_summary");
+  }
+  auto times_copy = times;
+  std::sort(times_copy.begin(), times_copy.end());
+  switch (sumstat)
+  {
+  case SummStat::E::MAX: return times_copy[0];
+  case SummStat::E::MEDIAN: return times_copy[times.size() / 2];
+  case SummStat::E::MEAN: return std::accumulate(times.begin(), times.end(), 0.) / times.size();
+  case SummStat::E::N: throw miog_error("N not allowed in SummStat in find ");
+  }
+  throw miog_error("unrecognised SummStat in get_summary");
+}
+
+std::vector<bool> get_thue_morse(size_t length)
+{
+  std::vector<bool> thue_morse{true, false};
+  while (thue_morse.size() < length)
+  {
+    for (auto x : thue_morse)
+    {
+      thue_morse.push_back(!x);
+    }
+  }
+  thue_morse.resize(length);
+  return thue_morse;
+}
+
+std::vector<double> remove_outliers(const std::vector<double>& times, double k)
+{
+  if (k <= 0 || times.size() < 3)
+  {
+    return times;
+  }
+
+  auto sorted = times;
+  std::sort(sorted.begin(), sorted.end());
+  double median = get_median(sorted);
+
+  std::vector<double> deviations;
+  for (auto& x : sorted)
+  {
+    deviations.push_back(std::abs(x - median));
+  }
+  std::sort(deviations.begin(), deviations.end());
+  // 1.4826 scales the MAD to the standard deviation for normally distributed times
+  double threshold = median + k * 1.4826 * get_median(deviations);
+
+  std::vector<double> kept;
+  for (auto& x : times)
+  {
+    if (x <= threshold)
+    {
+      kept.push_back(x);
+    }
+  }
+  return kept;
+}
+
+std::string Interval::get_string() const
+{
+  std::stringstream ss;
+  ss << estimate << " [" << lower << ", " << upper << "] [ms]";
+  return ss.str();
+}
+
+Interval get_bootstrap_interval(const std::vector<double>& times,
+                                SummStat::E                sumstat,
+                                double                     confidence,
+                                size_t                     n_resamples,
+                                unsigned                   seed)
+{
+  if (confidence <= 0 || confidence >= 1 || n_resamples == 0)
+  {
+    throw miog_error("confidence should be in (0, 1) and n_resamples strictly positive, "
+                     "in get_bootstrap_interval");
+  }
+
+  std::mt19937        gen(seed);
+  std::vector<double> summaries;
+  for (size_t ri = 0; ri < n_resamples; ++ri)
+  {
+    summaries.push_back(get_summary(get_resample(times, gen), sumstat));
+  }
+  std::sort(summaries.begin(), summaries.end());
+
+  double tail = (1 - confidence) / 2;
+  auto   li   = static_cast<size_t>(tail * (n_resamples - 1));
+  auto   ui   = static_cast<size_t>((1 - tail) * (n_resamples - 1));
+  return {summaries[li], get_summary(times, sumstat), summaries[ui]};
+}
+
+double get_confidence_faster(const std::vector<double>& challenger,
+                             const std::vector<double>& incumbent,
+                             SummStat::E                sumstat,
+                             size_t                     n_resamples,
+                             unsigned                   seed)
+{
+  if (n_resamples == 0)
+  {
+    throw miog_error("n_resamples should be strictly positive, in get_confidence_faster");
+  }
+
+  std::mt19937 gen(seed);
+  size_t       n_faster = 0;
+  for (size_t ri = 0; ri < n_resamples; ++ri)
+  {
+    n_faster += (get_summary(get_resample(challenger, gen), sumstat) <
+                 get_summary(get_resample(incumbent, gen), sumstat));
+  }
+  return static_cast<double>(n_faster) / n_resamples;
+}
+}
+}
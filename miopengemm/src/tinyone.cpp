@@ -220,6 +220,12 @@ Solution TinyOne<TFl>::find1(const FindParams& find_params, const Constraints& c
   return tgs;
 }
 
+template <typename TFl>
+std::vector<std::tuple<double, double>> TinyOne<TFl>::get_best_path() const
+{
+  return up_jinx->get_best_path();
+}
+
 template <typename TFl>
 void TinyOne<TFl>::accuracy_test(const HyPas& hp)  //, const TFl* c_true_for_test)
 {
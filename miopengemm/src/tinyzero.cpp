@@ -3,13 +3,16 @@
  *******************************************************************************/
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iomanip>
 #include <limits>
 #include <map>
+#include <memory>
 #include <numeric>
 #include <sstream>
 #include <thread>
 #include <tuple>
+#include <unordered_set>
 #include <vector>
 #include <miopengemm/architests.hpp>
 #include <miopengemm/bundle.hpp>
@@ -23,11 +26,13 @@
 #include <miopengemm/nearest.hpp>
 #include <miopengemm/oclutil.hpp>
 #include <miopengemm/outputwriter.hpp>
+#include <miopengemm/packedhypas.hpp>
 #include <miopengemm/programs.hpp>
 #include <miopengemm/redirection.hpp>
 #include <miopengemm/solution.hpp>
 #include <miopengemm/stringutilbase.hpp>
 #include <miopengemm/timer.hpp>
+#include <miopengemm/timingstats.hpp>
 #include <miopengemm/tinyzero.hpp>
 
 // TODO : checks on constraints to check for cleary non-derivables
@@ -36,11 +41,56 @@
 namespace MIOpenGEMM
 {
 
+namespace
+{
+
+// a challenger is only considered an improvement if the ratio new/old is less than this
+const double improvement_factor_required = 0.998;
+
+// moves HyPas with a low estimated occupancy or load efficiency (see architests::Resources) to
+// the back of front, keeping the order otherwise. Returns the number moved.
+size_t deprioritise_poor_resources(std::vector<HyPas>&     front,
+                                  const oclutil::DevInfo& devinfo,
+                                  const Geometry&         gg)
+{
+  auto it = std::stable_partition(front.begin(), front.end(), [&devinfo, &gg](const HyPas& hp) {
+    DerivedParams dp(hp, gg);
+    architests::Resources resources(devinfo, dp, gg, hp);
+    return resources.occupancy >= architests::low_occupancy &&
+           resources.load_efficiency >= architests::low_load_efficiency;
+  });
+  return static_cast<size_t>(front.end() - it);
+}
+
+// The time [s] at which a benchmark which has done runi runs in elapsed [s] will halt,
+// assuming the remaining runs take as long as the previous ones
+double get_halting_time(const Halt& hl, size_t runi, double elapsed)
+{
+  if (runi == 0 || elapsed <= 0)
+  {
+    return elapsed;
+  }
+  double per_run = elapsed / runi;
+  while (!hl.halt(runi, elapsed))
+  {
+    ++runi;
+    elapsed += per_run;
+  }
+  return elapsed;
+}
+}
+
 void   FindTracker::start() { timer.start(); }
-double FindTracker::get_elapsed() const { return timer.get_elapsed(); }
+double FindTracker::get_elapsed() const { return elapsed_before + timer.get_elapsed(); }
 
 void FindTracker::incr_descents() { ++descents; }
 void FindTracker::incr_kernels() { ++kernels; }
+void FindTracker::incr_avoided() { ++avoided; }
+void FindTracker::add_race_saving(double seconds)
+{
+  ++raced_out;
+  race_saving += seconds;
+}
 
 size_t FindTracker::get_descents() const { return descents; }
 
@@ -48,11 +98,40 @@ std::string FindTracker::get_string() const
 {
   auto format = [](const size_t& x) { return std::string("") + stringutil::get_padded(x, 7); };
   std::stringstream              track_ss;
-  track_ss << "[ELAPSED[s]:" << format(static_cast<int>(timer.get_elapsed()))
-           << "  #RESTARTS:" << format(descents) << "  #GEMMS:" << format(kernels) << "]       ";
+  track_ss << "[ELAPSED[s]:" << format(static_cast<int>(get_elapsed()))
+           << "  #RESTARTS:" << format(descents) << "  #GEMMS:" << format(kernels);
+  if (raced_out > 0)
+  {
+    track_ss << "  #RACED-OUT:" << format(raced_out)
+             << "  SAVED[s]:" << format(static_cast<int>(race_saving));
+  }
+  if (avoided > 0)
+  {
+    track_ss << "  #NOT-COMPILED:" << format(avoided);
+  }
+  track_ss << "]       ";
   return track_ss.str();
 }
 
+std::string FindTracker::get_state() const
+{
+  std::stringstream ss;
+  ss << std::setprecision(17) << get_elapsed() << ' ' << descents << ' ' << kernels << ' '
+     << raced_out << ' ' << race_saving << ' ' << avoided;
+  return ss.str();
+}
+
+void FindTracker::set_state(const std::string& state)
+{
+  std::stringstream ss(state);
+  ss >> elapsed_before >> descents >> kernels >> raced_out >> race_saving >> avoided;
+  if (ss.fail())
+  {
+    throw miog_error("failed to parse the state in FindTracker::set_state : " + state);
+  }
+  timer.start();
+}
+
 GpuMms::GpuMms(cl_mem           a_gpu_,
                cl_mem           b_gpu_,
                cl_mem           c_gpu_,
@@ -203,13 +282,96 @@ std::string TinyZero::get_run_time_string(cl_int status)
   return ss.str();
 }
 
+oclutil::Result TinyZero::run_launches(const AllKernArgs& all_kern_args, size_t n_launches)
+{
+  oclutil::SafeClEvent safe_first_event("Event of the first launch in find");
+  oclutil::SafeClEvent safe_last_event("Event to block on (final kernel) in find");
+  safe_first_event.clevent = cl_event{};
+  safe_last_event.clevent  = cl_event{};
+
+  bool debug_mode = false;
+
+  // the launches before the last are not waited on, so that they run back-to-back
+  for (size_t li = 0; li + 1 < n_launches; ++li)
+  {
+    auto oclr = programs.run(command_queue,
+                             all_kern_args,
+                             0,
+                             nullptr,
+                             nullptr,
+                             li == 0 ? &safe_first_event.clevent : nullptr,
+                             debug_mode);
+    if (oclr.fail())
+    {
+      return oclr;
+    }
+  }
+
+  auto oclr = programs.run(command_queue,
+                           all_kern_args,
+                           0,
+                           nullptr,
+                           &kernel_times,
+                           &safe_last_event.clevent,
+                           debug_mode);
+
+  if (!oclr.fail() && n_launches > 1)
+  {
+    KernelTime first_time;
+    first_time.update_times(safe_first_event.clevent);
+    size_t last_end = 0;
+    for (auto k_ind : programs.act_inds)
+    {
+      last_end = std::max(last_end, kernel_times.ktimes[k_ind].t_end);
+    }
+    kernel_times.extime = 1e-6 * (last_end - first_time.t_end) / (n_launches - 1);
+  }
+  return oclr;
+}
+
+size_t TinyZero::get_n_launches(const AllKernArgs& all_kern_args)
+{
+  if (!repeats.enabled)
+  {
+    return 1;
+  }
+
+  if (programs.get_n_active() == 0)
+  {
+    throw miog_error("zero kernels active : internal logic error");
+  }
+
+  size_t n_launches = 2;
+  while (n_launches < repeats.max_launches)
+  {
+    if (run_launches(all_kern_args, n_launches).fail())
+    {
+      break;
+    }
+    double per_launch = std::max(kernel_times.extime, 1e-6);
+    if (n_launches * per_launch >= repeats.min_run_time)
+    {
+      break;
+    }
+    auto needed = static_cast<size_t>(std::ceil(repeats.min_run_time / per_launch));
+    n_launches  = std::min(repeats.max_launches, std::max(2 * n_launches, needed));
+  }
+  return n_launches;
+}
+
 oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
                                     std::vector<double>&             all_times,
                                     const Halt&                      hl,
-                                    const AllKernArgs&               all_kern_args)
+                                    const AllKernArgs&               all_kern_args,
+                                    const Racing&                    racing,
+                                    double                           incumbent,
+                                    RaceStat*                        ptr_rstat,
+                                    size_t                           n_warmup)
 {
 
   size_t          runi{0};
+  size_t          n_warmed{0};
+  size_t          n_launches = get_n_launches(all_kern_args);
   oclutil::Result oclr;
   Timer           timer;
   timer.start();
@@ -225,19 +387,7 @@ oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
       throw miog_error("zero kernels active : internal logic error");
     }
 
-    oclutil::SafeClEvent safe_last_event("Event to block on (final kernel) in find");
-    safe_last_event.clevent = cl_event{};
-
-    bool update_times = false;
-    bool debug_mode   = false;
-
-    oclr = programs.run(command_queue,
-                        all_kern_args,
-                        update_times,
-                        nullptr,
-                        &kernel_times,
-                        &safe_last_event.clevent,
-                        debug_mode);
+    oclr = run_launches(all_kern_args, n_launches);
 
     if (oclr.success == CL_SUCCESS)
     {
@@ -264,18 +414,42 @@ oclutil::Result TinyZero::true_core(std::function<void(std::string)> acton,
 
     oclutil::cl_flush(command_queue, "cl flush in core gemm loop", true);
 
+    // warm-up launches are not timed, and do not count towards hl
+    if (n_warmed < n_warmup)
+    {
+      ++n_warmed;
+      timer.start();
+      continue;
+    }
+
     // act on the results string.
     acton(get_run_time_string(oclr.success));
 
     ++runi;
     all_times.push_back(kernel_times.extime);
+
+    if (racing.is_hopeless(all_times, incumbent))
+    {
+      if (ptr_rstat != nullptr)
+      {
+        ptr_rstat->abandoned = true;
+        ptr_rstat->saving =
+          get_halting_time(hl, runi, timer.get_elapsed()) - timer.get_elapsed();
+      }
+      break;
+    }
   }
 
   auto   best_time = *std::min_element(all_times.begin(), all_times.end());
   double gflops    = gg.get_gflops(best_time / 1000.);
   mowri.bw[OutPart::BEN] << gg.get_tabbed_string()
                          << "  time[ms]:" << stringutil::get_char_padded(best_time, 10)
-                         << "  gflops:" << gflops << Endl;
+                         << "  gflops:" << gflops;
+  if (n_launches > 1)
+  {
+    mowri.bw[OutPart::BEN] << "  launches/run:" << n_launches;
+  }
+  mowri.bw[OutPart::BEN] << Endl;
 
   return {};
 }
@@ -307,10 +481,55 @@ std::vector<double> TinyZero::benchgemm(const HyPas& hp, const Halt& hl)
         << "Entering the core gemm loops" << Endl << get_run_times_heading();
 
   std::vector<double> all_times;
-  true_core([this](std::string x) { mowri << x << '\n'; }, all_times, hl, all_kern_args);
+  true_core([this](std::string x) { mowri << x << '\n'; },
+            all_times,
+            hl,
+            all_kern_args,
+            Racing(),
+            std::numeric_limits<double>::max(),
+            nullptr,
+            get_n_warmup());
   return all_times;
 }
 
+void TinyZero::interleave(const Programs&      incumbent,
+                          const AllKernArgs&   incumbent_args,
+                          const Programs&      challenger,
+                          const AllKernArgs&   challenger_args,
+                          size_t               n_each,
+                          std::vector<double>& incumbent_run_times,
+                          std::vector<double>& challenger_run_times)
+{
+  Halt one_run({{1, 1}}, {{0, std::numeric_limits<double>::max()}});
+  incumbent_run_times.resize(0);
+  challenger_run_times.resize(0);
+
+  auto sequence = timingstats::get_thue_morse(2 * n_each);
+  for (size_t i = 0; i < sequence.size(); ++i)
+  {
+    bool                 is_incumbent = sequence[i];
+    std::vector<double>& times        = is_incumbent ? incumbent_run_times : challenger_run_times;
+    std::vector<double>  run_times;
+    programs = is_incumbent ? incumbent : challenger;
+    kernel_times.reset_times();
+    // only the first run of each is warmed up, the runs that follow are back-to-back
+    auto oclr = true_core([](std::string) {},
+                          run_times,
+                          one_run,
+                          is_incumbent ? incumbent_args : challenger_args,
+                          Racing(),
+                          std::numeric_limits<double>::max(),
+                          nullptr,
+                          i < 2 ? get_n_warmup() : 0);
+    if (oclr.fail())
+    {
+      throw miog_error("failed to run in TinyZero::interleave : " + oclr.message);
+    }
+    times.insert(times.end(), run_times.begin(), run_times.end());
+  }
+  programs = challenger;
+}
+
 AllKernArgs TinyZero::get_all_kern_args(const std::vector<KernBlob>& kblobs) const
 {
 
@@ -330,6 +549,28 @@ AllKernArgs TinyZero::get_all_kern_args(const std::vector<KernBlob>& kblobs) con
   return all_kern_args;
 }
 
+bool TinyZero::is_amortisation_halted(const FindTracker& ftrack, bool found) const
+{
+  return found && amortisation.halt(ftrack.get_elapsed());
+}
+
+Solution TinyZero::get_amortisation_default(const Constraints& constraints)
+{
+  size_t rank = 0;
+  auto soln   = get_default_soln(devinfo, gg, constraints, mowri, IfNoCache::E::GENERIC, rank);
+  soln.extime = amortisation.default_time;
+  return soln;
+}
+
+void TinyZero::record_best(double elapsed, double extime)
+{
+  // descents after the first record their own bests, which may not improve on earlier descents'
+  if (best_path.size() == 0 || extime < std::get<1>(best_path.back()))
+  {
+    best_path.emplace_back(elapsed, extime);
+  }
+}
+
 Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparms)
 {
 
@@ -342,34 +583,108 @@ Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparm
 
   address_check_valid_and_reliable();
 
+  noise        = fparms.noise;
+  repeats      = fparms.repeats;
+  amortisation = fparms.amortisation;
+  if (amortisation.is_enabled() && amortisation.default_time <= 0)
+  {
+    // the default solution find would return with no time allotted, benchmarked before the
+    // search clock starts, as it is not a cost of the search
+    size_t rank = 0;
+    auto dsoln  = get_default_soln(devinfo, gg, constraints, mowri, IfNoCache::E::GENERIC, rank);
+    amortisation.default_time =
+      timingstats::get_summary(benchgemm(dsoln.hypas, fparms.hl_core), fparms.sumstat);
+  }
+  if (amortisation.is_enabled())
+  {
+    mowri << "amortised find, of a kernel expected to run " << amortisation.invocations
+          << " times, with default solution time " << amortisation.default_time << " [ms]"
+          << Endl;
+  }
+
   FindTracker ftrack;
   ftrack.start();
+  best_path.clear();
   std::vector<Solution> v_solns;
 
   bool   warmstart      = true;
   size_t warmstart_rank = 0;
 
-  while (!fparms.hl_outer.halt(ftrack.get_descents(), ftrack.get_elapsed()))
-  {
-    mowri << "\nEntering new descent. \n"
-          << fparms.hl_outer.get_status(ftrack.get_descents(), ftrack.get_elapsed()) << '\n';
-
-    // 0, 1, 5, 10, 15, etc
-    warmstart = (ftrack.get_descents() < 2 || ftrack.get_descents() % 5 == 0) ? true : false;
+  checkpoint          = FindCheckpoint(devinfo.identifier, gg, constraints);
+  checkpoint_path     = fparms.checkpoint_path;
+  checkpoint_interval = fparms.checkpoint_interval;
+  checkpoint_last     = 0;
+  is_resumed          = fparms.resume_path != "";
 
-    double allotted_sd = std::max(1.0, fparms.hl_outer.max_time - ftrack.get_elapsed());
+  if (is_resumed)
+  {
+    checkpoint = read_checkpoint(fparms.resume_path, devinfo.identifier, gg, constraints);
+    ftrack.set_state(checkpoint.tracker_state);
+    set_graph_random_state(checkpoint.random_state);
+    warmstart_rank = checkpoint.warmstart_rank;
+    for (auto& x : checkpoint.solutions)
+    {
+      const HyPas& hp = std::get<0>(x);
+      v_solns.emplace_back(
+        gg, std::get<1>(x), kerngen::Bundle(hp, gg).v_tgks, hp, devinfo, constraints);
+    }
+    mowri << "resuming find from " << fparms.resume_path << " : " << checkpoint.get_n_recorded()
+          << " HyPas benchmarked, " << v_solns.size() << " descents complete, "
+          << ftrack.get_string() << Endl;
+  }
 
-    auto soln = single_descent_find(
-      allotted_sd, constraints, fparms.hl_core, ftrack, fparms.sumstat, warmstart, warmstart_rank);
-    v_solns.emplace_back(soln);
-    ftrack.incr_descents();
+  if (fparms.search != SearchType::E::DESCENT)
+  {
+    v_solns.emplace_back(strategy_find(constraints, fparms, ftrack));
+    checkpoint.solutions.emplace_back(v_solns.back().hypas, v_solns.back().extime);
+    update_checkpoint(ftrack, true);
+  }
 
-    if (warmstart)
+  else
+  {
+    // at least one descent, which returns a solution
+    while (ftrack.get_descents() == 0 ||
+           (!fparms.hl_outer.halt(ftrack.get_descents(), ftrack.get_elapsed()) &&
+            !is_amortisation_halted(ftrack, v_solns.size() > 0)))
     {
-      ++warmstart_rank;
+      mowri << "\nEntering new descent. \n"
+            << fparms.hl_outer.get_status(ftrack.get_descents(), ftrack.get_elapsed()) << '\n';
+
+      // 0, 1, 5, 10, 15, etc
+      warmstart = (ftrack.get_descents() < 2 || ftrack.get_descents() % 5 == 0) ? true : false;
+
+      double allotted_sd = std::max(1.0, fparms.hl_outer.max_time - ftrack.get_elapsed());
+
+      auto soln = single_descent_find(allotted_sd,
+                                      constraints,
+                                      fparms.hl_core,
+                                      ftrack,
+                                      fparms.sumstat,
+                                      warmstart,
+                                      warmstart_rank,
+                                      fparms.n_compile_ahead,
+                                      fparms.racing,
+                                      fparms.cost_ordered);
+      v_solns.emplace_back(soln);
+      ftrack.incr_descents();
+
+      if (warmstart)
+      {
+        ++warmstart_rank;
+      }
+
+      checkpoint.solutions.emplace_back(soln.hypas, soln.extime);
+      checkpoint.warmstart_rank = warmstart_rank;
+      update_checkpoint(ftrack, true);
     }
   }
 
+  if (v_solns.size() == 0)
+  {
+    mowri << "no solution found, returning the default solution" << Endl;
+    return get_amortisation_default(constraints);
+  }
+
   double              best_gflops     = 0;
   size_t              best_soln_index = 0;
   std::vector<double> soln_gflops;
@@ -385,6 +700,16 @@ Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparm
     }
   }
 
+  if (amortisation.is_enabled())
+  {
+    amortisation.record(ftrack.get_elapsed(), v_solns[best_soln_index].extime);
+    mowri << '\n' << "Amortisation    :  " << amortisation.get_string(ftrack.get_elapsed());
+    if (amortisation.halt(ftrack.get_elapsed()))
+    {
+      mowri << " (stopped as further search was not expected to pay for itself)";
+    }
+  }
+
   mowri << '\n'
         << "Search summary  :  " << ftrack.get_string() << '\n'
         << stringutil::get_star_wrapped("The gflops found by single descents:") << '\n'
@@ -407,19 +732,341 @@ Solution TinyZero::find0(const Constraints& constraints, const FindParams& fparm
   return v_solns[best_soln_index];
 }
 
+void TinyZero::update_checkpoint(const FindTracker& ftrack, bool force)
+{
+  if (checkpoint_path == "" ||
+      (!force && ftrack.get_elapsed() - checkpoint_last < checkpoint_interval))
+  {
+    return;
+  }
+  checkpoint.tracker_state = ftrack.get_state();
+  checkpoint.random_state  = get_graph_random_state();
+  checkpoint.write(checkpoint_path);
+  checkpoint_last = ftrack.get_elapsed();
+}
+
+bool TinyZero::set_compiled(const HyPas&           hp,
+                            size_t                 hfi,
+                            CompilePipeline*       pipeline,
+                            Programs&              progs,
+                            std::vector<KernBlob>& v_tgks,
+                            FindTracker&           ftrack)
+{
+  if (pipeline != nullptr)
+  {
+    auto candidate = pipeline->take(hfi);
+    if (candidate.is_good == false)
+    {
+      mowri << "architest failed: " << candidate.msg << Endl;
+      ftrack.incr_avoided();
+      return false;
+    }
+    progs  = std::move(candidate.programs);
+    v_tgks = std::move(candidate.v_tgks);
+    return true;
+  }
+
+  kerngen::Bundle  bundle(hp, gg);
+  architests::Stat atr(devinfo, bundle.dp, gg, hp);
+  if (atr.is_good == false)
+  {
+    mowri << "architest failed: " << atr.msg << Endl;
+    ftrack.incr_avoided();
+    return false;
+  }
+
+  // kernel compilation
+  progs.update(bundle.v_tgks);
+  v_tgks = bundle.v_tgks;
+  return true;
+}
+
+double TinyZero::evaluate(const HyPas&           hp,
+                          size_t                 hfi,
+                          CompilePipeline*       pipeline,
+                          const FindParams&      fparms,
+                          double                 incumbent,
+                          FindTracker&           ftrack,
+                          std::vector<KernBlob>& v_tgks,
+                          RaceStat&              rstat,
+                          std::vector<double>&   times)
+{
+  times.clear();
+  double t_recorded;
+  if (is_resumed && checkpoint.get_time(hp, t_recorded))
+  {
+    v_tgks = kerngen::Bundle(hp, gg).v_tgks;
+    return t_recorded;
+  }
+
+  ftrack.incr_kernels();
+  if (!set_compiled(hp, hfi, pipeline, programs, v_tgks, ftrack))
+  {
+    checkpoint.record(hp, std::numeric_limits<double>::max());
+    return std::numeric_limits<double>::max();
+  }
+
+  kernel_times.reset_times();
+  auto oclr = true_core([](std::string) {},
+                        times,
+                        fparms.hl_core,
+                        get_all_kern_args(v_tgks),
+                        fparms.racing,
+                        incumbent,
+                        &rstat,
+                        get_n_warmup());
+  if (oclr.fail())
+  {
+    mowri << "cl out of resources: " << oclr.message << Endl;
+    checkpoint.record(hp, std::numeric_limits<double>::max());
+    times.clear();
+    return std::numeric_limits<double>::max();
+  }
+
+  if (rstat.abandoned)
+  {
+    ftrack.add_race_saving(rstat.saving);
+  }
+  if (noise.enabled)
+  {
+    times = timingstats::remove_outliers(times, noise.outlier_k);
+  }
+  double t = timingstats::get_summary(times, fparms.sumstat);
+  checkpoint.record(hp, t);
+  update_checkpoint(ftrack, false);
+  return t;
+}
+
+bool TinyZero::update_incumbent(const std::vector<double>&   times,
+                                double                       t,
+                                const std::vector<KernBlob>& v_tgks,
+                                const Solution*              incumbent,
+                                SummStat::E                  sumstat)
+{
+  bool is_new_best = incumbent == nullptr || improvement_factor_required * incumbent->extime >= t;
+
+  // with noise control, an apparent improvement must be significant
+  if (noise.enabled && is_new_best && incumbent != nullptr && incumbent_times.size() > 0 &&
+      times.size() > 0)
+  {
+    std::vector<double> compared_incumbent  = incumbent_times;
+    std::vector<double> compared_challenger = times;
+    if (noise.n_interleaved > 0)
+    {
+      // a copy, as interleave sets programs
+      Programs challenger_programs = programs;
+      interleave(incumbent_programs,
+                 get_all_kern_args(incumbent->v_tgks),
+                 challenger_programs,
+                 get_all_kern_args(v_tgks),
+                 noise.n_interleaved,
+                 compared_incumbent,
+                 compared_challenger);
+      compared_incumbent  = timingstats::remove_outliers(compared_incumbent, noise.outlier_k);
+      compared_challenger = timingstats::remove_outliers(compared_challenger, noise.outlier_k);
+    }
+
+    double confidence = timingstats::get_confidence_faster(
+      compared_challenger, compared_incumbent, sumstat, noise.n_resamples);
+    is_new_best = confidence >= noise.confidence;
+    mowri << "faster than the incumbent with confidence " << confidence
+          << (is_new_best ? "" : " (not significant)") << Endl;
+  }
+
+  if (is_new_best && noise.enabled)
+  {
+    incumbent_times = times;
+    // challengers are compiled into new programs, so that the incumbent's are kept
+    if (noise.n_interleaved > 0 && times.size() > 0)
+    {
+      incumbent_programs          = programs;
+      const Program& main_program = incumbent_programs.programs[KType::E::MAIN];
+      programs = Programs(main_program.device_id, main_program.context, mowri);
+    }
+  }
+  return is_new_best;
+}
+
+Solution TinyZero::strategy_find(const Constraints& constraints,
+                                 const FindParams&  fparms,
+                                 FindTracker&       ftrack)
+{
+  // Make sure the cache is initialized before searching
+  get_kernel_cache(devinfo.identifier, gg.floattype);
+
+  const Graph graph(gg, devinfo, constraints, mowri);
+
+  // the default solution is the first HyPas proposed
+  size_t             rank = 0;
+  std::vector<HyPas> seeds{
+    get_default_soln(devinfo, gg, constraints, mowri, IfNoCache::E::RANDOM, rank).hypas};
+  auto strategy = get_search_strategy(fparms.search, graph, gg, seeds);
+
+  std::unique_ptr<CompilePipeline> pipeline;
+  if (fparms.n_compile_ahead > 0)
+  {
+    const Program& main_program = programs.programs[KType::E::MAIN];
+    pipeline.reset(new CompilePipeline(
+      main_program.device_id, main_program.context, gg, devinfo, fparms.n_compile_ahead, mowri));
+  }
+
+  mowri << "geometry : " << gg.get_string() << "\nsearch : " << SearchType::M().name[fparms.search]
+        << Endl;
+
+  std::vector<Solution> best_solns_path;
+  size_t                rounds = 0;
+  incumbent_times.clear();
+  while (!fparms.hl_outer.halt(rounds, ftrack.get_elapsed()))
+  {
+    if (is_amortisation_halted(ftrack, best_solns_path.size() > 0))
+    {
+      mowri << "stopping the search because further search is not expected to pay for itself"
+            << Endl;
+      break;
+    }
+
+    auto proposals = strategy->propose(fparms.n_per_round);
+    if (proposals.size() == 0)
+    {
+      mowri << "stopping the search because the strategy has nothing left to propose" << Endl;
+      break;
+    }
+
+    if (pipeline)
+    {
+      std::vector<bool> is_recorded(proposals.size(), false);
+      for (size_t pi = 0; pi < proposals.size(); ++pi)
+      {
+        double t_recorded;
+        is_recorded[pi] = is_resumed && checkpoint.get_time(proposals[pi], t_recorded);
+      }
+      pipeline->submit(proposals, is_recorded);
+    }
+
+    for (size_t pi = 0; pi < proposals.size(); ++pi)
+    {
+      double incumbent = best_solns_path.size() == 0 ? std::numeric_limits<double>::max()
+                                                     : best_solns_path.back().extime;
+      std::vector<KernBlob> v_tgks;
+      RaceStat              rstat;
+      std::vector<double>   times;
+      double                t = evaluate(
+        proposals[pi], pi, pipeline.get(), fparms, incumbent, ftrack, v_tgks, rstat, times);
+      strategy->observe(proposals[pi], t);
+
+      mowri << '[' << std::fixed << std::setprecision(2) << ftrack.get_elapsed()
+            << std::setprecision(6) << "s]\t" << proposals[pi].get_string() << "\t" << t
+            << " [ms]" << (rstat.abandoned ? " (raced out)" : "") << Endl;
+
+      if (t < std::numeric_limits<double>::max() && !rstat.abandoned &&
+          update_incumbent(times,
+                           t,
+                           v_tgks,
+                           best_solns_path.size() == 0 ? nullptr : &best_solns_path.back(),
+                           fparms.sumstat))
+      {
+        best_solns_path.emplace_back(gg, t, v_tgks, proposals[pi], devinfo, constraints);
+        amortisation.record(ftrack.get_elapsed(), t);
+        record_best(ftrack.get_elapsed(), t);
+        mowri << "(NEW BEST) " << gg.get_gflops(t / 1000.) << " gflops" << Endl;
+      }
+    }
+
+    ++rounds;
+    ftrack.incr_descents();
+  }
+
+  if (best_solns_path.size() == 0 && amortisation.is_enabled())
+  {
+    mowri << "no solution found in strategy_find, returning the default solution" << Endl;
+    return get_amortisation_default(constraints);
+  }
+
+  if (best_solns_path.size() == 0)
+  {
+    throw miog_error("\nThere were no solutions found in strategy_find. None of the proposed "
+                     "HyPas compiled and ran");
+  }
+
+  return best_solns_path.back();
+}
+
+size_t TinyZero::successive_halving(const std::vector<HyPas>&                 v_hps,
+                                    const std::vector<Programs>&              v_programs,
+                                    const std::vector<std::vector<KernBlob>>& v_v_tgks,
+                                    const Halt&                               core_halt,
+                                    const Racing&                             racing,
+                                    SummStat::E                               sumstat,
+                                    FindTracker&                              ftrack)
+{
+  size_t              n_candidates = v_programs.size();
+  std::vector<size_t> alive(n_candidates);
+  std::iota(alive.begin(), alive.end(), 0);
+  std::vector<std::vector<double>> v_times(n_candidates);
+  std::vector<double>              v_elapsed(n_candidates, 0);
+  std::vector<double>              v_summary(n_candidates);
+
+  size_t n_runs = racing.min_runs;
+  while (alive.size() > 1)
+  {
+    Halt round_halt({{n_runs, n_runs}}, {{0, core_halt.max_time}});
+    for (auto ci : alive)
+    {
+      programs = v_programs[ci];
+      kernel_times.reset_times();
+      std::vector<double> round_times;
+      Timer               timer;
+      timer.start();
+      auto oclr = true_core([](std::string) {},
+                            round_times,
+                            round_halt,
+                            get_all_kern_args(v_v_tgks[ci]),
+                            Racing(),
+                            std::numeric_limits<double>::max(),
+                            nullptr,
+                            get_n_warmup());
+      v_elapsed[ci] += timer.get_elapsed();
+      v_times[ci].insert(v_times[ci].end(), round_times.begin(), round_times.end());
+      v_summary[ci] = oclr.fail() ? std::numeric_limits<double>::max()
+                                  : timingstats::get_summary(v_times[ci], sumstat);
+    }
+
+    std::stable_sort(alive.begin(), alive.end(), [&v_summary](size_t a, size_t b) {
+      return v_summary[a] < v_summary[b];
+    });
+
+    size_t n_keep = (alive.size() + 1) / 2;
+    for (size_t ai = n_keep; ai < alive.size(); ++ai)
+    {
+      auto   ci     = alive[ai];
+      double t_halt = get_halting_time(core_halt, v_times[ci].size(), v_elapsed[ci]);
+      ftrack.add_race_saving(std::max(0., t_halt - v_elapsed[ci]));
+      ftrack.incr_kernels();
+      checkpoint.record(v_hps[ci], v_summary[ci]);
+    }
+    alive.resize(n_keep);
+    n_runs *= 2;
+  }
+
+  mowri << "successive halving over " << n_candidates << " candidates, winner is "
+        << alive[0] << Endl;
+  return alive[0];
+}
+
 Solution TinyZero::single_descent_find(double             allotted_time,
                                        const Constraints& constraints,
                                        const Halt&        core_halt,
                                        FindTracker&       ftrack,
                                        SummStat::E        sumstat,
                                        bool               warmstart,
-                                       size_t             warmstart_rank)
+                                       size_t             warmstart_rank,
+                                       size_t             n_compile_ahead,
+                                       const Racing&      racing,
+                                       bool               cost_ordered)
 {
 
-  // only considered an improvement if ratio new/old less than this
-  double improvement_factor_required = 0.998;
-
-  get_kernel_cache();  // Make sure the cache is initialized before starting timer
+  // Make sure the cache is initialized before starting timer
+  get_kernel_cache(devinfo.identifier, gg.floattype);
 
   Timer timer;
   timer.start();
@@ -437,7 +1084,7 @@ Solution TinyZero::single_descent_find(double             allotted_time,
   // ensure that we do not consider a HyperParam more than once
   // Maybe this should be in the outer find loop ?
   // Although then the stats between runs wouldn't be indep.
-  std::vector<HyPas> hyper_front_history;
+  std::unordered_set<PackedHyPas, PackedHyPasHash> hyper_front_history;
 
   // Keep track of the `records' as they get broken
   std::vector<Solution> best_solns_path;
@@ -450,6 +1097,8 @@ Solution TinyZero::single_descent_find(double             allotted_time,
   std::vector<double> v_t_total;
   double              k_seconds;
 
+  incumbent_times.clear();
+
   // the hyper params to be considered on a single wave
   std::vector<HyPas> hyper_front;
 
@@ -466,134 +1115,311 @@ Solution TinyZero::single_descent_find(double             allotted_time,
     auto soln =
       get_default_soln(devinfo, gg, constraints, mowri, IfNoCache::E::RANDOM, warmstart_rank);
     warm_start_hp = soln.hypas;
-    hyper_front   = {warm_start_hp};
+
+    // for skinny problems, a nearby cache entry is the warm start unless the generic skinny
+    // kernel is faster
+    bool compare_skinny =
+      warmstart_rank == 0 && checkpoint.front.size() == 0 && is_skinny(gg, constraints);
+    HyPas generic_skinny = compare_skinny ? get_generic(gg, constraints) : warm_start_hp;
+    if (compare_skinny && !(generic_skinny == warm_start_hp) && graph.contains(generic_skinny))
+    {
+      try
+      {
+        auto   times_warm    = benchgemm(warm_start_hp, core_halt);
+        auto   times_generic = benchgemm(generic_skinny, core_halt);
+        double t_warm        = timingstats::get_summary(times_warm, sumstat);
+        double t_generic     = timingstats::get_summary(times_generic, sumstat);
+        mowri << "skinny problem : cache entry " << t_warm << " [ms], generic skinny kernel "
+              << t_generic << " [ms]" << Endl;
+        if (t_generic < improvement_factor_required * t_warm)
+        {
+          warm_start_hp = generic_skinny;
+        }
+      }
+      catch (const miog_error& e)
+      {
+        mowri << "skinny problem : keeping the cache entry, benchmarking failed : " << e.what()
+              << Endl;
+      }
+    }
+    hyper_front = {warm_start_hp};
   }
 
   HyPas hp_curr;
 
+  // resuming a descent which was interrupted, from its front and best HyPas
+  if (checkpoint.front.size() > 0)
+  {
+    mowri << "resuming the descent from the checkpoint front (" << checkpoint.front.size()
+          << " HyPas)" << Endl;
+    hyper_front = checkpoint.front;
+    if (checkpoint.has_incumbent)
+    {
+      hp_curr = checkpoint.incumbent;
+      best_solns_path.emplace_back(gg,
+                                   checkpoint.incumbent_time,
+                                   kerngen::Bundle(hp_curr, gg).v_tgks,
+                                   hp_curr,
+                                   devinfo,
+                                   constraints);
+      disco_times.push_back(0);
+    }
+  }
+
+  // the front and best HyPas are checkpointed whenever the front changes
+  auto set_checkpoint_front = [this, &hyper_front, &best_solns_path]() {
+    checkpoint.front         = hyper_front;
+    checkpoint.has_incumbent = best_solns_path.size() > 0;
+    if (checkpoint.has_incumbent)
+    {
+      checkpoint.incumbent      = best_solns_path.back().hypas;
+      checkpoint.incumbent_time = best_solns_path.back().extime;
+    }
+  };
+  set_checkpoint_front();
+
+  // if compiling ahead, candidates are generated and compiled on worker threads
+  // while the current candidate is benchmarked
+  std::unique_ptr<CompilePipeline> pipeline;
+  if (n_compile_ahead > 0)
+  {
+    const Program& main_program = programs.programs[KType::E::MAIN];
+    pipeline.reset(new CompilePipeline(
+      main_program.device_id, main_program.context, gg, devinfo, n_compile_ahead, mowri));
+  }
+
   bool improvement_found_on_front = true;
 
-  while (improvement_found_on_front == true)
+  while (improvement_found_on_front == true &&
+         !is_amortisation_halted(ftrack, best_solns_path.size() > 0))
   {
     improvement_found_on_front = false;
     size_t hfi                 = 0;
 
+    // HyPas benchmarked before resuming are not benchmarked again
+    std::vector<bool> is_recorded(hyper_front.size(), false);
+    for (size_t i = 0; i < hyper_front.size(); ++i)
+    {
+      double t_recorded;
+      is_recorded[i] = is_resumed && checkpoint.get_time(hyper_front[i], t_recorded);
+    }
+
+    // cancels the candidates of the previous front which are not yet benchmarked
+    if (pipeline)
+    {
+      pipeline->submit(hyper_front, is_recorded);
+    }
+
     while (hfi < hyper_front.size() && improvement_found_on_front == false &&
-           timer.get_elapsed() < allotted_time)
+           timer.get_elapsed() < allotted_time &&
+           !is_amortisation_halted(ftrack, best_solns_path.size() > 0))
     {
 
-      hp_curr = hyper_front[hfi];
+      // the candidates raced against each other : a single candidate unless racing in batches
+      size_t batch_end = std::min(hyper_front.size(), hfi + racing.batch_size);
+      std::vector<HyPas>                 batch_hps;
+      std::vector<Programs>              batch_programs;
+      std::vector<std::vector<KernBlob>> batch_v_tgks;
 
-      hyper_front_history.push_back(hp_curr);
+      // a recorded HyPas is considered on its own, with its recorded time
+      bool   recorded   = false;
+      double t_recorded = 0;
 
-      // extra precaution, should be able to remove this
-      Derivabilty dblt(hp_curr, gg);
-      if (dblt.is_derivable == false)
+      for (; hfi < batch_end; ++hfi)
       {
-        std::stringstream errm;
-        errm << "Non-derivable in single descent find : " << dblt.msg << ".\n";
-        errm << "Geometry: " << gg.get_string() << '\n';
-        errm << "hp: " << hp_curr.get_string() << '\n';
-        throw miog_error(errm.str());
-      }
+        const HyPas& hp = hyper_front[hfi];
+        if (is_recorded[hfi] && batch_hps.size() > 0)
+        {
+          break;
+        }
 
-      kerngen::Bundle bundle(hp_curr, gg);
-      // the OpenCL string was succesfully generated,
-      // we can now attempt to compile and benchmark it
-      ++single_descent_counter;
+        hyper_front_history.insert(hp);
 
-      mowri << "\n[" << single_descent_counter << ", " << std::fixed << std::setprecision(2)
-            << timer.get_elapsed() << std::setprecision(6) << "s]\t" << hp_curr.get_string()
-            << Endl;
+        // extra precaution, should be able to remove this
+        if (!is_dvble(hp, gg))
+        {
+          Derivabilty       dblt(hp, gg);
+          std::stringstream errm;
+          errm << "Non-derivable in single descent find : " << dblt.msg << ".\n";
+          errm << "Geometry: " << gg.get_string() << '\n';
+          errm << "hp: " << hp.get_string() << '\n';
+          throw miog_error(errm.str());
+        }
 
-      architests::Stat atr(command_queue, bundle.dp, gg, hp_curr);
-      if (atr.is_good == false)
-      {
-        mowri << "architest failed: " << atr.msg << Endl;
-        ++hfi;
-        continue;
-      }
+        ++single_descent_counter;
 
-      // kernel compilation
-      auto compstat = programs.update(bundle.v_tgks);
+        mowri << "\n[" << single_descent_counter << ", " << std::fixed << std::setprecision(2)
+              << timer.get_elapsed() << std::setprecision(6) << "s]\t" << hp.get_string()
+              << Endl;
 
-      auto all_kern_args = get_all_kern_args(bundle.v_tgks);
+        if (is_recorded[hfi])
+        {
+          recorded = checkpoint.get_time(hp, t_recorded);
+          batch_hps.push_back(hp);
+          batch_programs.emplace_back();
+          batch_v_tgks.push_back(kerngen::Bundle(hp, gg).v_tgks);
+          ++hfi;
+          break;
+        }
 
-      old_track_msg = new_track_msg;
-      new_track_msg = ftrack.get_string();
-      mowri.bw[OutPart::E::TRA] << std::string(old_track_msg.size(), '\b');
-      mowri.bw[OutPart::E::TRA] << new_track_msg << Flush;
+        // when racing in batches, each candidate needs its own programs
+        Programs batch_progs;
+        if (racing.batch_size > 1)
+        {
+          const Program& main_program = programs.programs[KType::E::MAIN];
+          batch_progs = Programs(main_program.device_id, main_program.context, mowri);
+        }
 
-      v_t_total.resize(0);
-      kernel_times.reset_times();
-      std::vector<std::string> summary;
+        std::vector<KernBlob> v_tgks;
+        Programs&             progs = (racing.batch_size > 1) ? batch_progs : programs;
+        if (set_compiled(hp, hfi, pipeline.get(), progs, v_tgks, ftrack))
+        {
+          batch_hps.push_back(hp);
+          batch_programs.push_back(progs);
+          batch_v_tgks.push_back(std::move(v_tgks));
+        }
 
-      auto oclr = true_core([&summary, &v_t_total](std::string x) { summary.push_back(x); },
-                            v_t_total,
-                            core_halt,
-                            all_kern_args);
+        else
+        {
+          checkpoint.record(hp, std::numeric_limits<double>::max());
+        }
+      }
 
-      if (oclr.fail())
+      if (batch_hps.size() == 0)
       {
-        mowri << "cl out of resources: " << atr.msg << Endl;
-        ++hfi;
         continue;
       }
 
-      auto v_t_total_copy = v_t_total;
+      size_t winner = 0;
+      if (batch_hps.size() > 1)
+      {
+        winner = successive_halving(
+          batch_hps, batch_programs, batch_v_tgks, core_halt, racing, sumstat, ftrack);
+      }
+
+      hp_curr     = batch_hps[winner];
+      auto v_tgks = std::move(batch_v_tgks[winner]);
 
-      std::sort(v_t_total_copy.begin(), v_t_total_copy.end());
-      switch (sumstat)
+      bool is_new_best = false;
+      if (recorded)
       {
-      case SummStat::E::MAX: k_seconds    = v_t_total_copy[0]; break;
-      case SummStat::E::MEDIAN: k_seconds = v_t_total_copy[v_t_total.size() / 2]; break;
-      case SummStat::E::MEAN:
-        k_seconds = std::accumulate(v_t_total.begin(), v_t_total.end(), 0.) / v_t_total.size();
-        break;
-      case SummStat::E::N: throw miog_error("N not allowed in SummStat in find ");
+        mowri << "benchmarked before resuming : " << t_recorded << " [ms]" << Endl;
+        if (t_recorded == std::numeric_limits<double>::max())
+        {
+          continue;
+        }
+        k_seconds   = t_recorded;
+        is_new_best = update_incumbent(
+          {}, k_seconds, v_tgks, best_solns_path.size() == 0 ? nullptr : &best_solns_path.back(),
+          sumstat);
       }
 
-      mowri << get_run_times_heading() << Flush;
-      for (size_t ir = 0; ir < summary.size(); ++ir)
+      else
       {
-        mowri << summary[ir];
-        if (v_t_total[ir] >= k_seconds && v_t_total[ir] <= k_seconds)  // avoid == suppression
+        programs           = batch_programs[winner];
+        auto all_kern_args = get_all_kern_args(v_tgks);
+
+        old_track_msg = new_track_msg;
+        new_track_msg = ftrack.get_string();
+        mowri.bw[OutPart::E::TRA] << std::string(old_track_msg.size(), '\b');
+        mowri.bw[OutPart::E::TRA] << new_track_msg << Flush;
+
+        v_t_total.resize(0);
+        kernel_times.reset_times();
+        std::vector<std::string> summary;
+
+        double incumbent = best_solns_path.size() == 0 ? std::numeric_limits<double>::max()
+                                                       : best_solns_path.back().extime;
+        RaceStat rstat;
+
+        auto oclr = true_core([&summary, &v_t_total](std::string x) { summary.push_back(x); },
+                              v_t_total,
+                              core_halt,
+                              all_kern_args,
+                              racing,
+                              incumbent,
+                              &rstat,
+                              get_n_warmup());
+
+        ftrack.incr_kernels();
+
+        if (oclr.fail())
         {
-          mowri << " (" << SummStat::M().name[sumstat] << ')';
-          if (best_solns_path.size() > 0 &&
-              (improvement_factor_required * best_solns_path.back().extime >= k_seconds))
+          mowri << "cl out of resources: " << oclr.message << Endl;
+          checkpoint.record(hp_curr, std::numeric_limits<double>::max());
+          continue;
+        }
+
+        std::vector<double> v_t_kept =
+          noise.enabled ? timingstats::remove_outliers(v_t_total, noise.outlier_k) : v_t_total;
+        k_seconds = timingstats::get_summary(v_t_kept, sumstat);
+        checkpoint.record(hp_curr, k_seconds);
+        update_checkpoint(ftrack, false);
+
+        if (rstat.abandoned)
+        {
+          mowri << "raced out after " << v_t_total.size() << " runs, lower bound "
+                << racing.get_lower_bound(v_t_total) << " [ms] vs incumbent " << incumbent
+                << " [ms]" << Endl;
+          ftrack.add_race_saving(rstat.saving);
+          continue;
+        }
+
+        is_new_best = update_incumbent(
+          v_t_kept, k_seconds, v_tgks,
+          best_solns_path.size() == 0 ? nullptr : &best_solns_path.back(), sumstat);
+
+        mowri << get_run_times_heading() << Flush;
+        for (size_t ir = 0; ir < summary.size(); ++ir)
+        {
+          mowri << summary[ir];
+          if (v_t_total[ir] >= k_seconds && v_t_total[ir] <= k_seconds)  // avoid == suppression
           {
-            mowri << " (NEW BEST) ";
+            mowri << " (" << SummStat::M().name[sumstat] << ')';
+            if (best_solns_path.size() > 0 && is_new_best)
+            {
+              mowri << " (NEW BEST) ";
+            }
           }
+          mowri << '\n';
+        }
+
+        if (noise.enabled)
+        {
+          mowri << "runs kept " << v_t_kept.size() << " of " << v_t_total.size() << ", "
+                << SummStat::M().name[sumstat] << ' '
+                << timingstats::get_bootstrap_interval(
+                     v_t_kept, sumstat, noise.confidence, noise.n_resamples)
+                     .get_string()
+                << Endl;
         }
-        mowri << '\n';
       }
 
-      if (best_solns_path.size() == 0 ||
-          (improvement_factor_required * best_solns_path.back().extime >= k_seconds))
+      if (is_new_best)
       {
 
         improvement_found_on_front = true;
 
-        best_solns_path.emplace_back(gg, k_seconds, bundle.v_tgks, hp_curr, devinfo, constraints);
+        best_solns_path.emplace_back(gg, k_seconds, v_tgks, hp_curr, devinfo, constraints);
+        amortisation.record(ftrack.get_elapsed(), k_seconds);
+        record_best(ftrack.get_elapsed(), k_seconds);
         disco_times.push_back(timer.get_elapsed());
       }
-
-      ++hfi;
-      ftrack.incr_kernels();
     }
 
     if (improvement_found_on_front == true && allotted_time > timer.get_elapsed())
     {
       bool prioritize = single_descent_counter < 20;
-      auto neighbors  = graph.get_neighbors(hp_curr, prioritize);
+      auto neighbors  = graph.get_neighbors(hp_curr, prioritize, cost_ordered);
 
       // refreshing hyper front
       hyper_front.clear();
 
+      std::unordered_set<PackedHyPas, PackedHyPasHash> neighbors_seen;
       for (auto& hp : neighbors)
       {
-        if (std::count(neighbors.begin(), neighbors.end(), hp) > 1)
+        PackedHyPas packed_hp(hp);
+        if (neighbors_seen.insert(packed_hp).second == false)
         {
           throw miog_error("duplicates in neighbors not allowed, should have already been "
                            "filtered. Could filter out here, but less efficient ");
@@ -609,8 +1435,7 @@ Solution TinyZero::single_descent_find(double             allotted_time,
         }
 
         // filtering out if it has already been considered
-        else if (std::find(hyper_front_history.begin(), hyper_front_history.end(), hp) !=
-                 hyper_front_history.end())
+        else if (hyper_front_history.count(packed_hp) != 0)
         {
         }
 
@@ -630,17 +1455,44 @@ Solution TinyZero::single_descent_find(double             allotted_time,
       {
         hyper_front.push_back(warm_start_hp);  // slipping the pernicious hp on the back.
       }
+
+      size_t n_poor = deprioritise_poor_resources(hyper_front, devinfo, gg);
+      if (n_poor > 0)
+      {
+        mowri << n_poor << " of " << hyper_front.size()
+              << " HyPas on the new front have poor estimated resources, and are tried last"
+              << Endl;
+      }
+
+      set_checkpoint_front();
+      update_checkpoint(ftrack, false);
     }
   }
 
+  // the descent is complete, find0 checkpoints its solution
+  checkpoint.front.clear();
+  checkpoint.has_incumbent = false;
+
   mowri.bw[OutPart::E::TRA] << std::string(new_track_msg.size(), '\b') << Flush;
 
+  if (pipeline)
+  {
+    mowri << "candidates compiled ahead and cancelled by a change of front: "
+          << pipeline->get_n_cancelled() << Endl;
+  }
+
   if (timer.get_elapsed() >= allotted_time)
   {
     mowri << "stopping the search because allotted time has been surpassed: " << timer.get_elapsed()
           << " > " << allotted_time << Endl;
   }
 
+  else if (is_amortisation_halted(ftrack, best_solns_path.size() > 0))
+  {
+    mowri << "stopping the search because further search is not expected to pay for itself"
+          << Endl;
+  }
+
   else if (improvement_found_on_front == false)
   {
     mowri << "stopping the search because a locally minimal kernel has been found" << Endl;
@@ -651,6 +1503,12 @@ Solution TinyZero::single_descent_find(double             allotted_time,
     throw miog_error("why did the algorithm stop ? ");
   }
 
+  if (best_solns_path.size() == 0 && amortisation.is_enabled())
+  {
+    mowri << "no solution found in the descent, returning the default solution" << Endl;
+    return get_amortisation_default(constraints);
+  }
+
   if (best_solns_path.size() == 0)
   {
     throw miog_error("\nThere were no solutions found. This suggests that the initial kernel did "
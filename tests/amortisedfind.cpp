@@ -0,0 +1,41 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <string>
+#include <vector>
+#include <miopengemm/findparams.hpp>
+#include <miopengemm/tinyone.hpp>
+
+// Amortised finds (get_amortised), for a kernel expected to run many times and for one expected
+// to run only once, for which the search halts as soon as it may. Both return a solution.
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  CLHint         devhint(0, 0);
+  owrite::Writer mowri(Ver::E::TERMINAL, "");
+  Offsets        offsets  = get_padding_offsets();
+  bool           all_good = true;
+
+  Geometry gg = get_padded_geometry<float>(true, false, true, false, 400, 300, 500, 0);
+  dev::TinyOne<float> tiny(gg, offsets, mowri, devhint);
+
+  for (double invocations : {1e6, 1.})
+  {
+    std::cout << "\n\namortised find, " << invocations << " invocations\n";
+    // the default solution is benchmarked by find
+    FindParams find_params = get_amortised(invocations, 0, 10.);
+    Solution   soln        = tiny.find1(find_params, Constraints(""));
+    std::cout << soln.hypas.get_string() << "  " << soln.extime << " [ms]\n";
+    if (!(soln.extime > 0))
+    {
+      std::cout << "the solution of the amortised find has no time, FAILED\n";
+      all_good = false;
+    }
+    tiny.accuracy_test(soln.hypas);
+  }
+
+  std::cout << (all_good ? "\namortised finds passed\n" : "\nFAILED\n");
+  return all_good ? 0 : 1;
+}
@@ -0,0 +1,47 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <iostream>
+#include <string>
+#include <miopengemm/architests.hpp>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/kernelcache.hpp>
+
+// Checks that every entry of the shipped kernel cache passes the architests, as find warm-starts
+// from (and benchmarks) these entries. No device is required : the GCN limits are used.
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  const KernelCache& kernel_cache = get_kernel_cache();
+
+  size_t n_checked = 0;
+  size_t n_failed  = 0;
+  for (auto& ck : kernel_cache.get_keys())
+  {
+    oclutil::DevInfo devinfo(ck.dvc, ck.dvc, 64);
+    devinfo.device_local_mem_size      = 65536;
+    devinfo.device_max_work_group_size = 256;
+
+    const HyPas&  hp = kernel_cache.at(ck);
+    DerivedParams dp(hp, ck.gg);
+    architests::Stat atr(devinfo, dp, ck.gg, hp);
+    ++n_checked;
+    if (!atr.is_good)
+    {
+      ++n_failed;
+      std::cout << ck.get_string() << hp.get_string() << '\n' << atr.msg << '\n';
+    }
+  }
+
+  std::cout << "checked " << n_checked << " kernel cache entries, " << n_failed
+            << " failed the architests\n";
+
+  if (n_checked == 0 || n_failed > 0)
+  {
+    std::cout << "FAILED" << std::endl;
+    return 1;
+  }
+  return 0;
+}
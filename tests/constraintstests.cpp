@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <cstring>
+#include <string>
+#include <vector>
+#include <miopengemm/miogemm.hpp>
+#include <miopengemm/tinyone.hpp>
+
+// Accuracy tests of kernels with hyper-parameters forced by constraints, so that the features
+// which find may or may not select (DBL, PRF, LRW, GAL = STREAMK, GMV, IEK, WOS, DSK) are run.
+// The kernels are random, within the constraints.
+
+namespace
+{
+using namespace MIOpenGEMM;
+
+HyPas get_constrained(const Geometry&         gg,
+                      const Constraints&      constraints,
+                      const oclutil::DevInfo& devinfo,
+                      owrite::Writer&         mowri,
+                      bool&                   all_good)
+{
+  size_t rank = 0;
+  HyPas hp = get_default_soln(devinfo, gg, constraints, mowri, IfNoCache::E::RANDOM, rank).hypas;
+
+  HyPas forced(hp);
+  forced.replace_where_defined(constraints);
+  if (!(forced == hp))
+  {
+    std::cout << hp.get_string() << " does not satisfy the constraints, FAILED\n";
+    all_good = false;
+  }
+  return hp;
+}
+}
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  CLHint           devhint(0, 0);
+  owrite::Writer   mowri(Ver::E::TERMINAL, "");
+  oclutil::DevInfo devinfo(devhint, mowri);
+  Offsets          offsets        = get_padding_offsets();
+  size_t           workspace_size = 4000 * 1000;
+  bool             all_good       = true;
+
+  // k is large enough for ICE 4 and for double buffering (DBL), m and n are not multiples of
+  // the macro tiles (IEK), and n of the skinny geometry is small enough for GMV
+  Geometry gg =
+    get_padded_geometry<float>(true, false, true, false, 333, 279, 1029, workspace_size);
+  Geometry gg_skinny =
+    get_padded_geometry<float>(true, false, true, false, 333, 7, 1029, workspace_size);
+
+  std::vector<std::string> constraint_strings = {"C_DBL1",
+                                                 "A_PRF1__B_PRF1",
+                                                 "A_LRW4",
+                                                 "C_GAL4",
+                                                 "C_GMV1",
+                                                 "C_IEK1",
+                                                 "A_WOS1__B_WOS2",
+                                                 "C_ICE4_DSK1"};
+
+  for (auto& constraint_string : constraint_strings)
+  {
+    const Geometry& gg_x = constraint_string == "C_GMV1" ? gg_skinny : gg;
+    std::cout << "\n\n" << constraint_string << "  " << gg_x.get_string() << '\n';
+
+    Constraints         constraints(constraint_string);
+    dev::TinyOne<float> tiny(gg_x, offsets, mowri, devhint);
+    HyPas               hp = get_constrained(gg_x, constraints, devinfo, mowri, all_good);
+    std::cout << hp.get_string() << '\n';
+    tiny.accuracy_test(hp);
+
+    // the splits in k of DSK are reduced in a fixed order, so c is the same on every run
+    if (constraint_string == "C_ICE4_DSK1")
+    {
+      std::vector<float> c_first = tiny.get_c_copy();
+      tiny.accuracy_test(hp);
+      const std::vector<float>& c_second = tiny.get_c_copy();
+      if (c_first.size() != c_second.size() ||
+          std::memcmp(c_first.data(), c_second.data(), c_first.size() * sizeof(float)) != 0)
+      {
+        std::cout << "two runs of the DSK kernel are not bit-identical, FAILED\n";
+        all_good = false;
+      }
+      else
+      {
+        std::cout << "two runs of the DSK kernel are bit-identical\n";
+      }
+    }
+  }
+
+  std::cout << (all_good ? "\nall constrained kernels passed\n" : "\nFAILED\n");
+  return all_good ? 0 : 1;
+}
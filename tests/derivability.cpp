@@ -0,0 +1,113 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <iostream>
+#include <string>
+#include <miopengemm/derivedparams.hpp>
+#include <miopengemm/graph.hpp>
+#include <miopengemm/randomutil.hpp>
+
+// Checks that the fast predicate is_dvble agrees with Derivabilty, over random HyPas drawn from
+// the full ranges of the Graph, and over their neighbors in the Graph. No device is required.
+
+namespace
+{
+using namespace MIOpenGEMM;
+
+RandomUtil radutil(1011);
+
+SuHy get_random_in_range(const SuGr& subg)
+{
+  std::vector<size_t> vs(subg.range.size());
+  for (size_t hpi = 0; hpi < vs.size(); ++hpi)
+  {
+    vs[hpi] = subg.range[hpi][radutil.get_from_range(subg.range[hpi].size())];
+  }
+  return SuHy(subg.emat, std::move(vs));
+}
+
+bool agrees(const HyPas& hp, const Geometry& gg)
+{
+  bool slow = false;
+  try
+  {
+    slow = Derivabilty(hp, gg).is_derivable;
+  }
+  catch (const miog_error&)
+  {
+    // Derivabilty throws on some logic errors, these are not derivable.
+  }
+
+  if (slow != is_dvble(hp, gg))
+  {
+    std::cout << "FAILED : is_dvble is " << !slow << " and Derivabilty is " << slow
+              << ".\nhp : " << hp.get_string() << "\ngeometry : " << gg.get_string() << '\n';
+    return false;
+  }
+  return true;
+}
+}
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+  std::vector<Geometry> geometries = {
+    {"tC0_tA0_tB0_colMaj1_m1_n1002_k77_lda1_ldb77_ldc1_ws0_f32"},
+    {"tC0_tA1_tB0_colMaj1_m363_n363_k1002_lda1002_ldb1002_ldc363_ws0_f32"},
+    {"tC0_tA0_tB1_colMaj1_m77_n1002_k363_lda77_ldb1002_ldc77_ws100000_f32"},
+    {"tC0_tA1_tB0_colMaj1_m6144_n16_k2048_lda2048_ldb2048_ldc6144_ws0_f32"},
+    {"tC0_tA0_tB0_colMaj1_m1000_n3_k513_lda1000_ldb513_ldc1000_ws0_f32"},
+    {"tC0_tA0_tB0_colMaj1_m1760_n7000_k1760_lda1760_ldb1760_ldc1760_ws20000000_f32"},
+    {"tC0_tA0_tB1_colMaj1_m4096_n4096_k4096_lda4100_ldb4096_ldc4097_ws0_f64"},
+    {"tC0_tA1_tB1_colMaj0_m81_n71_k58_lda90_ldb81_ldc92_ws1000000_f32"}};
+
+  owrite::Writer   mowri(Ver::E::SILENT, "");
+  oclutil::DevInfo devinfo    = oclutil::get_fiji_devinfo();
+  Constraints      no_constraints("");
+  size_t           n_random   = 20000;
+  size_t           n_checked  = 0;
+  size_t           n_dvble    = 0;
+  bool             all_agreed = true;
+
+  for (auto& gg : geometries)
+  {
+    ASuGr asubg(gg, no_constraints.sub[Mat::E::A], devinfo);
+    BSuGr bsubg(gg, no_constraints.sub[Mat::E::B], devinfo);
+    CSuGr csubg(gg, no_constraints.sub[Mat::E::C], devinfo);
+    for (SuGr* subg : std::vector<SuGr*>{&asubg, &bsubg, &csubg})
+    {
+      subg->initialise();
+    }
+
+    Graph graph(gg, devinfo, no_constraints, mowri);
+
+    for (size_t i = 0; i < n_random; ++i)
+    {
+      HyPas hp(std::array<SuHy, Mat::E::N>{
+        {get_random_in_range(asubg), get_random_in_range(bsubg), get_random_in_range(csubg)}});
+      ++n_checked;
+      all_agreed = agrees(hp, gg) && all_agreed;
+      if (is_dvble(hp, gg))
+      {
+        ++n_dvble;
+        for (auto& neighbor : graph.get_neighbors(hp, false))
+        {
+          ++n_checked;
+          all_agreed = agrees(neighbor, gg) && all_agreed;
+        }
+      }
+    }
+  }
+
+  std::cout << "checked " << n_checked << " HyPas, of which " << n_dvble
+            << " random starts are derivable\n";
+
+  if (!all_agreed || n_dvble == 0)
+  {
+    std::cout << "FAILED" << std::endl;
+    return 1;
+  }
+  std::cout << "is_dvble and Derivabilty agree" << std::endl;
+  return 0;
+}
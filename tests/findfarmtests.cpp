@@ -0,0 +1,96 @@
+/*******************************************************************************
+ * Copyright (C) 2017 Advanced Micro Devices, Inc. All rights reserved.
+ *******************************************************************************/
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <miopengemm/findfarm.hpp>
+
+// A FindFarm queue of 4 short finds on device 0 (a CPU OpenCL device will do), of which one
+// crashes and one hangs until it times out. The other two must be found and be in the merged
+// database, and the two failures must be reported.
+
+int main()
+{
+  using namespace MIOpenGEMM;
+
+#ifdef _WIN32
+  std::cout << "FindFarm is not supported on Windows, not tested\n";
+  return 0;
+#else
+
+  owrite::Writer mowri(Ver::E::TERMINAL, "");
+
+  // the job with m = crash_m crashes, and the one with m = hang_m hangs
+  size_t crash_m = 65;
+  size_t hang_m  = 66;
+
+  std::vector<FarmJob> jobs;
+  for (size_t m : {size_t(64), crash_m, hang_m, size_t(67)})
+  {
+    jobs.emplace_back(get_padded_geometry<float>(true, false, false, false, m, 48, 40, 0),
+                      Constraints(""));
+  }
+
+  FarmParams params;
+  params.devices       = {CLHint(0, 0)};
+  params.find_params   = get_at_least_n_seconds(0.5);
+  params.job_timeout   = 20;
+  params.max_attempts  = 1;
+  params.database_path = "findfarmtests_database.txt";
+  params.worker_setup  = [crash_m, hang_m](const FarmJob& job) {
+    if (job.gg.m == crash_m)
+    {
+      std::abort();
+    }
+    if (job.gg.m == hang_m)
+    {
+      std::this_thread::sleep_for(std::chrono::hours(1));
+    }
+  };
+  std::remove(params.database_path.c_str());
+
+  FindFarm farm(params, mowri);
+  auto     results  = farm.run(jobs);
+  bool     all_good = true;
+
+  auto check = [&all_good](bool ok, const std::string& what) {
+    std::cout << what << (ok ? "" : " FAILED") << '\n';
+    all_good = all_good && ok;
+  };
+
+  check(results.size() == jobs.size(), "a result per job");
+  for (auto& result : results)
+  {
+    std::cout << result.job.get_string() << " : "
+              << (result.is_found ? result.hypas.get_string() : result.message) << '\n';
+    if (result.job.gg.m == crash_m)
+    {
+      check(!result.is_found && result.message.find("signal") != std::string::npos,
+            "the crashing job is reported as killed by a signal");
+    }
+    else if (result.job.gg.m == hang_m)
+    {
+      check(!result.is_found && result.message.find("timed out") != std::string::npos,
+            "the hanging job is reported as timed out");
+    }
+    else
+    {
+      check(result.is_found && result.extime > 0, "the job is found");
+    }
+  }
+
+  // the successful jobs, and only they, are in the database, as written and as read back
+  check(farm.get_database().get_size() == 2, "2 entries in the merged database");
+  check(read_tuning_database(params.database_path).get_size() == 2,
+        "2 entries in the database file");
+  std::remove(params.database_path.c_str());
+
+  std::cout << (all_good ? "\nfind farm passed\n" : "\nFAILED\n");
+  return all_good ? 0 : 1;
+#endif
+}